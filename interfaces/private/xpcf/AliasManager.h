@@ -30,12 +30,6 @@
 #include <xpcf/component/ComponentBase.h>
 #include "tinyxmlhelper.h"
 
-#ifdef XPCF_WITH_LOGS
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
-#endif
-
 #include <thread>
 #include <vector>
 #include <map>
@@ -91,9 +85,6 @@ private:
 
     SRef<AliasContext> m_context;
     std::map<Type,std::function<void(const std::string & name, const uuids::uuid & uuid,bool)>> m_addAliasFunction;
-#ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
-#endif
 };
 
 template <> struct ComponentTraits<AliasManager>
@@ -30,12 +30,6 @@
 #include <xpcf/collection/Collection.h>
 #include "tinyxmlhelper.h"
 
-#ifdef XPCF_WITH_LOGS
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
-#endif
-
 #include <boost/filesystem.hpp>
 #include "Factory.h"
 #include "Registry.h"
@@ -62,7 +56,6 @@ public:
     SRef<IComponentIntrospect> createComponent(const char * instanceName, const uuids::uuid& componentUUID) override;
 
     void unloadComponent () override final;
-    void releaseComponent(uuids::uuid componentUUID);
 
     const IEnumerable<SPtr<ModuleMetadata>> & getModulesMetadata() const override;
     SPtr<ComponentMetadata> findComponentMetadata(const uuids::uuid &) const override;
@@ -79,9 +72,6 @@ private:
     ComponentManager& operator=(const ComponentManager&)= delete;
     static std::atomic<ComponentManager*> m_instance;
     static std::mutex m_mutex;
-#ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
-#endif
     SRef<AbstractFactory> m_factory;
     SRef<IPropertyManager> m_propertyManager;
 
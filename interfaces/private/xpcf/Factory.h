@@ -27,40 +27,62 @@
 #include <xpcf/api/IFactory.h>
 #include <xpcf/component/ComponentFactory.h>
 
-#include <deque>
 #include "AliasManager.h"
 #include "Registry.h"
 #include "PropertyManager.h"
 #include <xpcf/component/ComponentBase.h>
 #include "tinyxmlhelper.h"
+#include "FlatHashTable.h"
+#include "FootprintRecorder.h"
 #include <xpcf/collection/Collection.h>
 
-#ifdef XPCF_WITH_LOGS
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
-#endif
-
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
 #include <thread>
+#include <tuple>
 #include <vector>
 #include <map>
 
 namespace org { namespace bcom { namespace xpcf {
 
+constexpr uint32_t BindingPoolSize_Default = 16;
+
 struct FactoryBindInfos {
     uuids::uuid componentUUID;
     BindingScope scope;
     uint8_t bindingRangeMask = 0;
     std::string properties;
+    // maximum number of idle instances kept for the Pooled scope
+    uint32_t poolSize = BindingPoolSize_Default;
 };
 
 constexpr uint8_t BindingRange_Core = 0;
 
-struct FactoryContext {
+struct FactoryBindings;
+
+// Immutable hash indexed copy of the bindings, compiled by IFactory::freeze().
+// Specific bindings are keyed upon [target component Uuid, interface Uuid], named bindings upon [interface Uuid, name].
+struct FrozenBindings {
+    FlatHashTable<FactoryBindInfos> autoBindings;
+    FlatHashTable<FactoryBindInfos> defaultBindings;
+    FlatHashTable<std::vector<FactoryBindInfos>> multiBindings;
+    FlatHashTable<FactoryBindInfos> namedBindings;
+    FlatHashTable<std::function<SRef<IComponentIntrospect>(void)>> factoryMethods;
+    FlatHashTable<FactoryBindInfos> specificBindings;
+    FlatHashTable<FactoryBindInfos> specificNamedBindings;
+
+    static SRef<const FrozenBindings> compile(const FactoryBindings & bindings);
+};
+
+// A published FactoryBindings snapshot is never modified : a modification is applied on a copy that replaces the snapshot.
+// Resolutions read the snapshot without any lock, and keep it alive until they end.
+struct FactoryBindings : public utils::enable_shared_from_this<FactoryBindings> {
     // interface Uuid resolves to [ component Uuid , scope ]
     std::map<uuids::uuid, FactoryBindInfos> autoBindings;
     std::map<uuids::uuid, FactoryBindInfos> defaultBindings;
-    std::map<uuids::uuid, VectorCollection<FactoryBindInfos>> multiBindings;
+    std::map<uuids::uuid, std::vector<FactoryBindInfos>> multiBindings;
 
     // default and multibind properties association
     // [interface UUID, component UUID] => properties name
@@ -80,8 +102,120 @@ struct FactoryContext {
     // component Uuid resolves to [ [interface Uuid , name] , [component Uuid , scope] ]
     std::map<uuids::uuid, std::map<std::pair<uuids::uuid,std::string>, FactoryBindInfos> > specificNamedBindings;
 
+    // incremented upon each context modification : resolution plans built with a previous revision are outdated
+    uint64_t revision = 0;
+
+    // set once the context is frozen : lookups use the hash tables, that are compiled again upon each modification
+    SRef<const FrozenBindings> frozen;
+
+    // set for an overlay context : the parent context bindings, searched when no local bind matches
+    SRef<const FactoryBindings> parent;
+
+    // lookups search the local binds, then the parent bindings. They return nullptr when no bind matches
+    const FactoryBindInfos * findAutoBind(const uuids::uuid & interfaceUUID) const;
+    const FactoryBindInfos * findDefaultBind(const uuids::uuid & interfaceUUID) const;
+    const std::vector<FactoryBindInfos> * findMultiBinds(const uuids::uuid & interfaceUUID) const;
+    const FactoryBindInfos * findNamedBind(const uuids::uuid & interfaceUUID, const std::string & name) const;
+    const std::function<SRef<IComponentIntrospect>(void)> * findFactoryMethod(const uuids::uuid & componentUUID) const;
+    const FactoryBindInfos * findSpecificBind(const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID) const;
+    const FactoryBindInfos * findSpecificNamedBind(const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID,
+                                                   const std::string & name) const;
+};
+
+class FactoryContext {
+public:
+    FactoryContext();
+    // overlay context : binds are searched in parent context when no local bind matches
+    explicit FactoryContext(const SRef<FactoryContext> & parent);
+    FactoryContext & operator=(const FactoryContext & other);
+
+    // returns the current bindings snapshot. The snapshot of an overlay context is rebased upon the current snapshot of its parent.
+    SRef<const FactoryBindings> bindings() const;
+    // applies modifier upon a copy of the current bindings, and publishes the copy as the new snapshot with a new revision.
+    // Concurrent updates are serialized.
+    // once frozen, the bindings are compiled again upon each update
+    void update(const std::function<void(FactoryBindings &)> & modifier);
+    void clear();
+    void freeze();
+    bool frozen() const { return bindings()->frozen != nullptr; }
+
+private:
+    SRef<const FactoryBindings> rebase(const SRef<const FactoryBindings> & parentBindings) const;
+
+    mutable SRef<const FactoryBindings> m_bindings;
+    mutable std::mutex m_updateMutex;
+    SRef<FactoryContext> m_parent;
+};
+
+// Singleton instance holder : the instance is created once, even when several threads resolve it concurrently.
+// Once created, the instance is returned without any lock.
+struct SingletonInstance {
+    template <typename F> SRef<IComponentIntrospect> get(F createInstance);
+    // creation duration of the instance, once created
+    std::chrono::microseconds duration() const { return m_duration; }
+
+private:
+    std::atomic<bool> m_created{false};
+    std::mutex m_mutex;
+    SRef<IComponentIntrospect> m_instance;
+    std::chrono::microseconds m_duration{0};
+};
+
+template <typename F> SRef<IComponentIntrospect> SingletonInstance::get(F createInstance)
+{
+    if (!m_created.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_created.load(std::memory_order_relaxed)) {
+            auto start = std::chrono::steady_clock::now();
+            SRef<IComponentIntrospect> componentRef = createInstance();
+            if (!componentRef) {
+                // creation aborted : the instance remains to create
+                return componentRef;
+            }
+            m_duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            m_instance = componentRef;
+            m_created.store(true, std::memory_order_release);
+        }
+    }
+    return m_instance;
+}
+
+// Instances of the components bound with the PerThread scope, for one thread and one factory.
+// The storage is only accessed by its thread : it is found through the thread local storage of the thread.
+struct PerThreadStorage {
+    std::map<std::tuple<uuids::uuid, std::string>, SRef<IComponentIntrospect>, std::less<>> instances;
+};
+
+// Per thread storages of a factory : the factory owns the per thread instances of every thread.
+// The instances of every thread are released upon clear and with the factory, the instances of a thread upon its exit.
+class PerThreadRegistry {
+public:
+    SRef<PerThreadStorage> add();
+    void remove(const PerThreadStorage * storage);
     void clear();
 
+private:
+    std::mutex m_mutex;
+    std::vector<SRef<PerThreadStorage>> m_storages;
+};
+
+// Pool of the idle instances of a component bound with the Pooled scope.
+// An instance released by its last user returns to the pool through its recycler, unless the pool already holds poolSize instances.
+// The pool owns its idle instances : they are unloaded with the pool.
+class ComponentPool : public utils::enable_shared_from_this<ComponentPool> {
+public:
+    ComponentPool(uint32_t poolSize):m_poolSize(poolSize) {}
+    ~ComponentPool();
+    // returns an idle instance (its reference count is null) or nullptr when the pool is empty
+    ComponentBase * acquire();
+    std::function<bool(ComponentBase *)> recycler();
+
+private:
+    bool recycle(ComponentBase * component);
+
+    uint32_t m_poolSize;
+    std::mutex m_mutex;
+    std::vector<ComponentBase *> m_instances;
 };
 
 enum class ContextType {
@@ -91,7 +225,85 @@ enum class ContextType {
     Multi
 };
 
-using BindContext = std::pair<ContextType, FactoryBindInfos>;
+// A binding context level links to its parent level, from the component currently resolved up to the root resolution.
+// Levels are created upon the resolution call stack and reference the bind infos stored in the bindings snapshot :
+// walking down the components tree neither copies nor allocates any context.
+struct BindContext {
+    ContextType type;
+    const FactoryBindInfos & bindInfos;
+    const BindContext * parent = nullptr;
+
+    const BindContext & root() const {
+        const BindContext * level = this;
+        while (level->parent != nullptr) {
+            level = level->parent;
+        }
+        return *level;
+    }
+};
+
+struct ResolutionPlan;
+
+// Resolution of one injectable of a component : one component plan for single injectables,
+// one plan per multibind component for multi injectables.
+// resolved is false when an optional injectable had no binding.
+struct LazyResolution;
+
+struct InjectablePlan {
+    InjectablePlan() = default;
+    InjectablePlan(const uuids::uuid & uuid, const std::string & injectableName, bool isMulti, bool isLazy)
+        :interfaceUUID(uuid), name(injectableName), multi(isMulti), lazy(isLazy) {}
+
+    uuids::uuid interfaceUUID;
+    std::string name;
+    bool multi = false;
+    bool lazy = false;
+    bool resolved = false;
+    std::vector<SRef<ResolutionPlan>> components;
+    // lazy injectables are not resolved upon injection : the plan records how to resolve them later on
+    SRef<const LazyResolution> lazyResolution;
+};
+
+// A resolution plan caches the outcome of a resolution for a component and its whole injection subtree :
+// the bind found, the create function, the configuration path and the plans of each injectable (in declaration order).
+// Plans are replayed by further resolutions of the same interface as long as the factory context revision is unchanged.
+struct ResolutionPlan {
+    FactoryBindInfos bindInfos;
+    // name of the bind used to resolve the component (used as named singleton key)
+    std::string name;
+    std::function<SRef<IComponentIntrospect>(void)> createComponent;
+    fs::path configFilePath;
+    std::vector<InjectablePlan> injectables;
+    // singleton holder for singleton scope, and for scoped scope within a scope
+    SRef<SingletonInstance> singleton;
+    // true for the PerThread scope : instances are found in the thread local storage
+    bool perThread = false;
+    // idle instances for pooled scope
+    SRef<ComponentPool> pool;
+    // false when the plan was recorded upon an existing singleton instance : the subtree is unknown
+    bool complete = false;
+};
+
+// A lazy resolution holds what a lazy injectable needs to be resolved upon its first use with the bindings and context levels
+// of the injection : the bindings snapshot and a copy of the binding context chain, from the root level.
+struct LazyResolution {
+    SRef<const FactoryBindings> bindings;
+    std::vector<std::pair<ContextType, FactoryBindInfos>> contexts;
+    uuids::uuid interfaceUUID;
+    std::string name;
+    // plan recorded upon the first resolution, replayed for the lazy handles of further component instances
+    mutable SRef<ResolutionPlan> plan;
+};
+
+// A published ResolutionPlanTable is never modified : new plans are added upon a copy that replaces the table.
+struct ResolutionPlanTable {
+    // bindings revision the plans were recorded with
+    uint64_t revision = 0;
+    // [interface Uuid, name] resolves to the plan recorded upon the first resolution
+    std::map<std::pair<uuids::uuid,std::string>, SRef<ResolutionPlan>> plans;
+    // interface Uuid resolves to the plan recorded upon the first resolveAll
+    std::map<uuids::uuid, SRef<InjectablePlan>> multiPlans;
+};
 
 inline bool operator==(const FactoryBindInfos& lhs, const FactoryBindInfos& rhs)
 {
@@ -104,7 +316,7 @@ class AbstractFactory : virtual public IFactory {
 public:
     virtual ~AbstractFactory() override = default;
     virtual void autobind(const uuids::uuid & interfaceUUID, const uuids::uuid & instanceUUID) = 0;
-    virtual void inject(SRef<IInjectable> component, std::deque<BindContext> contextLevels = {}) = 0;
+    virtual void inject(SRef<IInjectable> component) = 0;
     virtual void declareFactory(tinyxml2::XMLElement * xmlModuleElt) = 0;
 };
 
@@ -119,6 +331,9 @@ class Factory : public ComponentBase,
         virtual public AbstractFactory, virtual public IAliasManager, virtual public IRegistryManager {
 public:
     Factory();
+    // child factory upon parent : shares the core components of parent.
+    // An overlay (ContextMode::Overlay) overlays the bindings of parent, a scope (ContextMode::Shared) shares them
+    Factory(const Factory * parent, ContextMode ctxMode);
     ~Factory() override = default;
     void clear() override;
     void autobind(const uuids::uuid & interfaceUUID, const uuids::uuid & instanceUUID) override;
@@ -175,30 +390,30 @@ public:
 
     void declareFactory(tinyxml2::XMLElement * xmlModuleElt) override;
     SRef<IComponentIntrospect> resolve(const SPtr<InjectableMetadata> & injectableInfo) override
-        { return resolve(injectableInfo, {}); }
-    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID) override
-        { return resolve(interfaceUUID, std::deque<BindContext>()); }
-    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID, const std::string & name) override
-        { return resolve(interfaceUUID, name, {}); }
+        { return resolve(injectableInfo, *m_context->bindings(), nullptr); }
+    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID) override;
+    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID, const std::string & name) override;
     const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const SPtr<InjectableMetadata> & injectableInfo) override
-        { return resolveAll(injectableInfo, {}); }
-    const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const uuids::uuid & interfaceUUID) override
-        { return resolveAll(interfaceUUID, {}); }
-
-    SRef<IComponentIntrospect> resolve(const SPtr<InjectableMetadata> & injectableInfo,
-                                       std::deque<BindContext> contextLevels);
-    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID,
-                                       std::deque<BindContext> contextLevels);
-    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID, const std::string & name,
-                                       std::deque<BindContext> contextLevels);
-    const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const SPtr<InjectableMetadata> & injectableInfo,
-                                                   std::deque<BindContext> contextLevels);
-    const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const uuids::uuid & interfaceUUID,
-                                       std::deque<BindContext> contextLevels);
+        { return resolveAll(injectableInfo->getUuid(), *m_context->bindings(), nullptr); }
+    const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const uuids::uuid & interfaceUUID) override;
+
     uuids::uuid getComponentUUID(const uuids::uuid & interfaceUUID) override;
     uuids::uuid getComponentUUID(const uuids::uuid & interfaceUUID, const std::string & name) override;
 
     SRef<IFactory> createNewFactoryContext(ContextMode ctxMode) override;
+    SRef<IFactory> createScope() override;
+    void enableParallelInjection(bool enable) override { m_parallelInjection = enable; }
+    bool parallelInjectionEnabled() const override { return m_parallelInjection; }
+    void freeze() override { m_context->freeze(); }
+    bool frozen() const override { return m_context->frozen(); }
+    void setAsyncExecutor(const AsyncExecutor & executor) override;
+    void executeAsync(const std::function<void(void)> & task) override;
+    std::vector<SingletonWarmupInfos> warmup() override;
+    void enableFootprintReport(bool enable, AllocatedBytesCounter counter) override;
+    std::vector<ComponentFootprint> footprintReport() const override;
+    std::vector<BatchResolution> resolveMany(const std::vector<std::pair<uuids::uuid,std::string>> & requests, bool parallel = false) override;
+    result<SRef<IComponentIntrospect>, XPCFErrorCode> tryResolve(const uuids::uuid & interfaceUUID) override;
+    result<SRef<IComponentIntrospect>, XPCFErrorCode> tryResolve(const uuids::uuid & interfaceUUID, const std::string & name) override;
 
     // IComponentManager methods
     SRef<IComponentIntrospect> createComponent(const uuids::uuid & componentUUID) override;
@@ -225,6 +440,18 @@ public:
     XPCFErrorCode loadModules(const char* folderPathStr, bool bRecurse) override
         { return m_resolver->loadModules(folderPathStr, bRecurse); }
 
+    void enableModuleIndexCache(bool enable) override
+        { m_resolver->enableModuleIndexCache(enable); }
+
+    void setModuleIndexCachePath(const char* cacheFilePath) override
+        { m_resolver->setModuleIndexCachePath(cacheFilePath); }
+
+    XPCFErrorCode buildModuleIndexCache(const char* folderPathStr, bool bRecurse) override
+        { return m_resolver->buildModuleIndexCache(folderPathStr, bRecurse); }
+
+    std::vector<std::string> verifyModuleIndexCache(const char* folderPathStr, bool bRecurse) const override
+        { return m_resolver->verifyModuleIndexCache(folderPathStr, bRecurse); }
+
     XPCFErrorCode loadModuleMetadata(const char* moduleName,
                                      const char* moduleFilePath) override
         { return m_resolver->loadModuleMetadata(moduleName, moduleFilePath); }
@@ -259,37 +486,117 @@ private:
     void declareMultiBind(const uuids::uuid & interfaceUUID, tinyxml2::XMLElement * xmlBindElt);
     void declareInject(tinyxml2::XMLElement * xmlBindElt);
     void declareSpecificBind(tinyxml2::XMLElement * xmlBindElt, const uuids::uuid & targetComponentUUID);
+    Factory * createFactory(ContextMode ctxMode);
+    AsyncExecutor asyncExecutor() const;
     FactoryBindInfos getComponentBindingInfos(tinyxml2::XMLElement * xmlBindElt);
     SRef<IComponentIntrospect> create(const uuids::uuid& componentUUID);
     XPCFErrorCode loadLibrary(fs::path configurationFilePath);
     template <class T> XPCFErrorCode load(fs::path folderPath);
     SRef<IComponentIntrospect> resolveFromModule(const uuids::uuid & componentUUID);
-    SRef<IComponentIntrospect> resolveComponent(const FactoryBindInfos & bindInfos,
-                                                std::deque<BindContext> contextLevels);
-    void inject(SRef<IInjectable> component,
-                std::deque<BindContext> contextLevels={}) final;
+    // opens the library of a module declared in a configuration file in the background
+    void prefetchModule(tinyxml2::XMLElement * xmlModuleElt);
+    void inject(SRef<IInjectable> component) final;
+    void inject(SRef<IInjectable> component, const FactoryBindings & bindings, const BindContext * context, ResolutionPlan * plan);
+    void injectConcurrently(SRef<IInjectable> component, const FactoryBindings & bindings, const BindContext * context, ResolutionPlan * plan);
+    void inject(IInjectable & component, SPtr<Injector> injectable, const FactoryBindings & bindings, const BindContext * context, InjectablePlan * plan);
+    void injectLazy(IInjectable & component, SPtr<Injector> injectable, const FactoryBindings & bindings, const BindContext * context, InjectablePlan * plan);
+    LazyResolver lazyResolver(const SRef<const LazyResolution> & lazy);
+    SRef<IComponentIntrospect> resolve(const LazyResolution & lazy);
+    SRef<IComponentIntrospect> resolve(const SPtr<InjectableMetadata> & injectableInfo, const FactoryBindings & bindings,
+                                       const BindContext * context, ResolutionPlan * plan = nullptr);
+    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings,
+                                       const BindContext * context, ResolutionPlan * plan = nullptr);
+    SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID, const std::string & name, const FactoryBindings & bindings,
+                                       const BindContext * context, ResolutionPlan * plan = nullptr);
+    const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings,
+                                                                   const BindContext * context, InjectablePlan * plan = nullptr);
+    SRef<IComponentIntrospect> resolveComponent(const FactoryBindInfos & bindInfos, const FactoryBindings & bindings,
+                                                const BindContext & context, ResolutionPlan * plan);
+    SRef<IComponentIntrospect> resolveInstance(const FactoryBindInfos & bindInfos, const std::string & name, const FactoryBindings & bindings,
+                                               const BindContext & context, ResolutionPlan * plan);
+    SRef<SingletonInstance> singletonInstance(const FactoryBindInfos & bindInfos, const std::string & name);
+    SRef<SingletonInstance> scopedInstance(const FactoryBindInfos & bindInfos, const std::string & name);
+    template <typename F> SRef<IComponentIntrospect> perThreadInstance(const FactoryBindInfos & bindInfos, const std::string & name,
+                                                                       F createInstance);
+    SRef<IComponentIntrospect> acquire(ComponentPool & pool);
+    void track(ComponentPool & pool, SRef<IComponentIntrospect> componentRef);
+    SRef<FootprintRecorder> footprintRecorder() const;
+    void configure(SRef<IComponentIntrospect> componentRef, const FactoryBindInfos & bindInfos, const fs::path & configFilePath);
+    // resolution plans handling
+    SRef<ResolutionPlan> findResolutionPlan(const std::pair<uuids::uuid,std::string> & key, uint64_t revision) const;
+    SRef<InjectablePlan> findResolutionPlan(const uuids::uuid & interfaceUUID, uint64_t revision) const;
+    void updateResolutionPlans(uint64_t revision, const std::function<void(ResolutionPlanTable &)> & modifier);
+    SRef<IComponentIntrospect> resolveFromPlan(const uuids::uuid & interfaceUUID, const std::string & name);
+    SRef<IComponentIntrospect> resolveFromPlan(const uuids::uuid & interfaceUUID, const std::string & name,
+                                               const SRef<const FactoryBindings> & bindings);
+    SRef<IComponentIntrospect> replay(const ResolutionPlan & plan);
+    SRef<IComponentIntrospect> replayComponent(const ResolutionPlan & plan);
+    bool replayInjection(SRef<IInjectable> component, const ResolutionPlan & plan);
+    bool replayInjectionConcurrently(SRef<IInjectable> component, const ResolutionPlan & plan);
+    bool replay(IInjectable & component, SPtr<Injector> injectable, const InjectablePlan & plan);
+    const SRef<IEnumerable<SRef<IComponentIntrospect>>> replay(const InjectablePlan & plan);
     SPtr<ModuleMetadata> resolveMetadataFromComponentUUID(const uuids::uuid & componentUUID) {
         return m_resolver->findModuleMetadata(m_resolver->getModuleUUID(componentUUID));
     }
-    FactoryBindInfos resolveBind(const uuids::uuid & interfaceUUID, std::deque<BindContext> contextLevels);
-    FactoryBindInfos resolveBind(const uuids::uuid & interfaceUUID, const std::string & name,  std::deque<BindContext> contextLevels );
+    // bind lookups without exception : the result holds _ERROR_INJECTABLE_NOBIND when no bind matches.
+    // The error message is only built upon describeError, as it costs two uuids::to_string
+    using BindResult = result<const FactoryBindInfos *, XPCFErrorCode>;
+    BindResult tryResolveBind(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings, const BindContext * context,
+                              bool describeError = false);
+    BindResult tryResolveBind(const uuids::uuid & interfaceUUID, const std::string & name, const FactoryBindings & bindings,
+                              const BindContext * context, bool describeError = false);
+    bool hasBind(SPtr<Injector> injectable, const FactoryBindings & bindings, const BindContext * context);
+    const FactoryBindInfos & resolveBind(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings, const BindContext * context);
+    const FactoryBindInfos & resolveBind(const uuids::uuid & interfaceUUID, const std::string & name, const FactoryBindings & bindings,
+                                         const BindContext * context);
 #ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
     std::stringstream log(const FactoryBindInfos & bindInfos);
 #endif
     // The factory context contains every declared bind
     SRef<FactoryContext> m_context;
 
-    // component Uuid resolves to IComponentIntrospect reference
-    std::map<uuids::uuid,SRef<IComponentIntrospect> > m_singletonInstances;
+    // component Uuid resolves to singleton instance holder
+    std::map<uuids::uuid,SRef<SingletonInstance> > m_singletonInstances;
 
-    // [component Uuid, name] resolves to IComponentIntrospect reference
-    std::map<std::pair<uuids::uuid,std::string>,SRef<IComponentIntrospect> > m_namedSingletonInstances;
+    // [component Uuid, name] resolves to singleton instance holder
+    std::map<std::pair<uuids::uuid,std::string>,SRef<SingletonInstance> > m_namedSingletonInstances;
 
+    // core bindings and factory methods are declared upon construction and never modified
     std::map<uuids::uuid, FactoryBindInfos> m_coreBindings;
-    std::map<uuids::uuid,SRef<IComponentIntrospect> > m_coreInstances;
+    std::map<uuids::uuid,SRef<SingletonInstance> > m_coreInstances;
     // component UUID resolves to create function
     std::map<uuids::uuid, std::function<SRef<IComponentIntrospect>(void)>> m_coreFactoryMethods;
+    // [component Uuid, name] resolves to the holder of the instance shared within the scope
+    std::map<std::pair<uuids::uuid,std::string>,SRef<SingletonInstance> > m_scopedInstances;
+    // guards the singleton and scoped holders maps
+    std::mutex m_instancesMutex;
+
+    // set for a scope : the factory the scope was created from, that holds the singleton instances
+    SRef<IFactory> m_parentRef;
+    Factory * m_parent = nullptr;
+
+    // per thread instances of the factory, shared with its scopes
+    SRef<PerThreadRegistry> m_perThreadRegistry;
+
+    // resolution plans table, replaced upon each plan addition
+    SRef<const ResolutionPlanTable> m_resolutionPlans;
+    std::mutex m_resolutionPlansMutex;
+    // the factory holding the resolution plans : the scopes use the plans of the factory they were created from
+    Factory * m_root = this;
+
+    // set for an overlay factory : the core components belong to the parent factory
+    bool m_overlay = false;
+
+    // when set, the injectables of a component are resolved concurrently
+    std::atomic<bool> m_parallelInjection{false};
+
+    // runs the asynchronous resolutions : the xpcf task pool when empty
+    AsyncExecutor m_asyncExecutor;
+    mutable std::mutex m_asyncExecutorMutex;
+
+    // records the components constructions when the footprint report is enabled
+    SRef<FootprintRecorder> m_footprintRecorder;
+    std::atomic<bool> m_footprintEnabled{false};
 
     SRef<AbstractRegistry> m_resolver;
     SRef<AbstractAliasManager> m_aliasManager;
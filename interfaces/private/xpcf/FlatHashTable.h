@@ -0,0 +1,150 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief immutable open addressing hash table upon uuid keys
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_FLATHASHTABLE_H
+#define ORG_BCOM_XPCF_FLATHASHTABLE_H
+
+#include "xpcf/core/uuid.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace org { namespace bcom { namespace xpcf {
+
+/**
+ * @class FlatHashTable
+ * @brief Immutable hash table built once from its entries, for lookups upon [uuid, uuid, name] keys.
+ *
+ * Entries are stored contiguously and indexed by an open addressing (linear probing) slots array.
+ * Keys whose second uuid or name are unused leave them nil or empty.
+ * UUIDs are random : their first bytes are used as hash, and the name is only hashed when not empty.
+ * A slot keeps the full hash of its entry : keys are only compared upon a full hash match.
+ */
+template <typename V>
+class FlatHashTable {
+public:
+    struct Entry {
+        uuids::uuid first;
+        uuids::uuid second;
+        std::string name;
+        V value;
+    };
+
+    FlatHashTable() = default;
+    // entries keys must be unique
+    explicit FlatHashTable(std::vector<Entry> && entries);
+
+    const V * find(const uuids::uuid & first) const { return find(first, uuids::uuid{}, std::string()); }
+    const V * find(const uuids::uuid & first, const std::string & name) const { return find(first, uuids::uuid{}, name); }
+    const V * find(const uuids::uuid & first, const uuids::uuid & second) const { return find(first, second, std::string()); }
+    const V * find(const uuids::uuid & first, const uuids::uuid & second, const std::string & name) const;
+    std::size_t size() const { return m_entries.size(); }
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        // entry index + 1, 0 for an empty slot
+        uint32_t entry = 0;
+    };
+
+    static uint64_t hash(const uuids::uuid & first, const uuids::uuid & second, const std::string & name);
+
+    std::vector<Slot> m_slots;
+    std::vector<Entry> m_entries;
+    uint64_t m_mask = 0;
+};
+
+inline uint64_t uuidBits(const uuids::uuid & uuid)
+{
+    uint64_t bits = 0;
+#ifdef XPCF_USE_BOOST
+    std::memcpy(&bits, uuid.begin(), sizeof(bits));
+#else
+    std::memcpy(&bits, uuid.as_bytes().data(), sizeof(bits));
+#endif
+    return bits;
+}
+
+template <typename V>
+uint64_t FlatHashTable<V>::hash(const uuids::uuid & first, const uuids::uuid & second, const std::string & name)
+{
+    // handwritten uuids are not as random as generated ones : mix the bits (murmur3 finalizer)
+    uint64_t h = uuidBits(first) ^ (uuidBits(second) * 0x9e3779b97f4a7c15ULL);
+    if (!name.empty()) {
+        h ^= std::hash<std::string>()(name) * 0xc2b2ae3d27d4eb4fULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+template <typename V>
+FlatHashTable<V>::FlatHashTable(std::vector<Entry> && entries):m_entries(std::move(entries))
+{
+    if (m_entries.empty()) {
+        return;
+    }
+    // load factor is kept at or below 0.5 to keep probe sequences short
+    std::size_t slotsCount = 8;
+    while (slotsCount < 2 * m_entries.size()) {
+        slotsCount *= 2;
+    }
+    m_slots.resize(slotsCount);
+    m_mask = slotsCount - 1;
+    for (uint32_t i = 0; i < m_entries.size(); i++) {
+        const Entry & entry = m_entries[i];
+        uint64_t h = hash(entry.first, entry.second, entry.name);
+        uint64_t index = h & m_mask;
+        while (m_slots[index].entry != 0) {
+            index = (index + 1) & m_mask;
+        }
+        m_slots[index].hash = h;
+        m_slots[index].entry = i + 1;
+    }
+}
+
+template <typename V>
+const V * FlatHashTable<V>::find(const uuids::uuid & first, const uuids::uuid & second, const std::string & name) const
+{
+    if (m_slots.empty()) {
+        return nullptr;
+    }
+    uint64_t h = hash(first, second, name);
+    for (uint64_t index = h & m_mask; m_slots[index].entry != 0; index = (index + 1) & m_mask) {
+        const Slot & slot = m_slots[index];
+        if (slot.hash == h) {
+            const Entry & entry = m_entries[slot.entry - 1];
+            if (entry.first == first && entry.second == second && entry.name == name) {
+                return &entry.value;
+            }
+        }
+    }
+    return nullptr;
+}
+
+}}} //namespace org::bcom::xpcf
+
+#endif // ORG_BCOM_XPCF_FLATHASHTABLE_H
@@ -0,0 +1,97 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief components construction cost recording
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_FOOTPRINTRECORDER_H
+#define ORG_BCOM_XPCF_FOOTPRINTRECORDER_H
+
+#include "xpcf/api/IFactory.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace org { namespace bcom { namespace xpcf {
+
+/**
+ * @class FootprintRecorder
+ * @brief Aggregates the construction costs of the components per component type.
+ */
+class FootprintRecorder {
+public:
+    explicit FootprintRecorder(AllocatedBytesCounter counter):m_counter(counter) {}
+    uint64_t allocatedBytes() const { return (m_counter != nullptr) ? m_counter() : 0; }
+    void record(const ComponentFootprint & footprint);
+    // the recorded footprints, in the component UUID order. The names are left empty
+    std::vector<ComponentFootprint> report() const;
+
+private:
+    AllocatedBytesCounter m_counter;
+    mutable std::mutex m_mutex;
+    std::map<uuids::uuid, ComponentFootprint> m_footprints;
+};
+
+/**
+ * @class FootprintScope
+ * @brief Measures the construction of one component on the calling thread.
+ *
+ * Each phase is measured between start() and stop(). The costs of the components constructed within a phase by nested
+ * scopes of the same thread are subtracted from the phase : they are recorded on their own component type.
+ * A scope without recorder measures nothing.
+ */
+class FootprintScope {
+public:
+    enum class Phase {
+        Creation,
+        Injection,
+        Configuration
+    };
+
+    explicit FootprintScope(FootprintRecorder * recorder);
+    ~FootprintScope();
+    FootprintScope(const FootprintScope &) = delete;
+    FootprintScope & operator=(const FootprintScope &) = delete;
+
+    void start();
+    void stop(Phase phase);
+    // records the measured phases for the component type componentUUID
+    void commit(const uuids::uuid & componentUUID);
+
+    // sets the instance size of the component measured by the innermost scope of the calling thread
+    static void recordInstanceSize(std::size_t size);
+
+private:
+    FootprintRecorder * m_recorder;
+    FootprintScope * m_parent = nullptr;
+    ComponentFootprint m_footprint;
+    uint64_t m_startBytes = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+    // costs of the nested scopes, accumulated while they complete
+    uint64_t m_nestedBytes = 0;
+    std::chrono::nanoseconds m_nestedDuration{0};
+    uint64_t m_nestedBytesAtStart = 0;
+    std::chrono::nanoseconds m_nestedDurationAtStart{0};
+};
+
+}}} //namespace org::bcom::xpcf
+
+#endif // ORG_BCOM_XPCF_FOOTPRINTRECORDER_H
@@ -0,0 +1,92 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief xpcf internal logging facility
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_LOGGER_H
+#define ORG_BCOM_XPCF_LOGGER_H
+
+#ifdef XPCF_WITH_LOGS
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/trivial.hpp>
+#endif
+
+// minimal severity of the log statements compiled in : 0 trace, 1 debug, 2 info, 3 warning, 4 error, 5 fatal
+#ifndef XPCF_LOG_LEVEL
+#define XPCF_LOG_LEVEL 2
+#endif
+
+namespace org { namespace bcom { namespace xpcf { namespace log {
+
+enum class Level {
+    trace = 0,
+    debug,
+    info,
+    warning,
+    error,
+    fatal
+};
+
+#ifdef XPCF_WITH_LOGS
+using Logger = boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>;
+
+/**
+ * @return the logger shared by every instance of the class @em className. The logger is created upon the first call.
+ * The first logger creation installs the xpcf asynchronous sink : records are pushed to a lock-free queue
+ * and written to std::clog by the sink thread, so that logging never blocks upon I/O.
+ */
+Logger & getLogger(const char * className);
+
+/**
+ * Waits until the records already logged are written.
+ */
+void flush();
+#endif
+
+// swallows the log statements compiled out
+struct NullStream {
+    template <typename T> const NullStream & operator<<(const T &) const { return *this; }
+};
+
+}}}} //namespace org::bcom::xpcf::log
+
+#ifdef XPCF_WITH_LOGS
+/**
+ * Defines the logger used by XPCF_LOG in a translation unit, shared by the instances of CLASSNAME.
+ */
+#define XPCF_DEFINE_LOGGER(CLASSNAME) \
+    namespace { \
+    inline ::org::bcom::xpcf::log::Logger & classLogger() { \
+        static ::org::bcom::xpcf::log::Logger & logger = ::org::bcom::xpcf::log::getLogger(CLASSNAME); \
+        return logger; \
+    } \
+    }
+
+// statements below XPCF_LOG_LEVEL are discarded by the compiler
+#define XPCF_LOG(LEVEL) \
+    if (static_cast<int>(::org::bcom::xpcf::log::Level::LEVEL) < XPCF_LOG_LEVEL) {} \
+    else BOOST_LOG_SEV(classLogger(), ::boost::log::trivial::LEVEL)
+#else
+#define XPCF_DEFINE_LOGGER(CLASSNAME)
+#define XPCF_LOG(LEVEL) if (true) {} else ::org::bcom::xpcf::log::NullStream()
+#endif
+
+#endif // ORG_BCOM_XPCF_LOGGER_H
@@ -0,0 +1,107 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief persistent cache of the introspected modules metadata
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_MODULEINDEXCACHE_H
+#define ORG_BCOM_XPCF_MODULEINDEXCACHE_H
+
+#include "xpcf/api/ModuleMetadata.h"
+#include "xpcf/api/ComponentMetadata.h"
+#include "xpcf/api/InterfaceMetadata.h"
+
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace org { namespace bcom { namespace xpcf {
+
+/**
+ * @class ModuleIndexCache
+ * @brief Stores the metadata of the introspected modules in a binary cache file.
+ *
+ * Each module entry is keyed by the module library path, and records the library size, modification time and content hash.
+ * An entry is used while the library size and modification time are unchanged. When only the modification time changed,
+ * the content hash decides whether the entry is still valid.
+ * The entry records the module, its components with their interfaces, and the metadata of these interfaces :
+ * a cached module is declared without loading its library.
+ */
+class ModuleIndexCache {
+public:
+    explicit ModuleIndexCache(const fs::path & cacheFilePath = defaultPath()):m_cacheFilePath(cacheFilePath) {}
+
+    // the default cache file : ~/.xpcf/modules.cache
+    static fs::path defaultPath();
+
+    // reads the cache file. A missing, truncated or incompatible cache file is ignored
+    void load();
+    // writes the cache file when entries changed since the last load or save
+    void save();
+
+    // returns the module metadata cached for the library modulePath, or nullptr when the entry is missing or outdated
+    SPtr<ModuleMetadata> find(const fs::path & modulePath);
+    // returns the metadata of the interfaces implemented by the components of the module cached for modulePath
+    std::vector<SPtr<InterfaceMetadata>> getInterfaces(const fs::path & modulePath) const;
+    // replaces the entry of the library modulePath with the module metadata and its interfaces metadata
+    void store(const fs::path & modulePath, SPtr<ModuleMetadata> moduleInfos, const std::vector<SPtr<InterfaceMetadata>> & interfaces);
+    // checks the library size, modification time and content hash against the entry of modulePath
+    bool isUpToDate(const fs::path & modulePath) const;
+    // removes the entries whose library no longer exists
+    void prune();
+
+private:
+    struct MetadataRecord {
+        uuids::uuid uuid;
+        std::string name;
+        std::string description;
+    };
+
+    struct ComponentRecord {
+        MetadataRecord metadata;
+        std::vector<uuids::uuid> interfaces;
+    };
+
+    struct ModuleRecord {
+        uint64_t size = 0;
+        int64_t lastWriteTime = 0;
+        uint64_t contentHash = 0;
+        MetadataRecord metadata;
+        std::string folderPath;
+        std::vector<ComponentRecord> components;
+        std::vector<MetadataRecord> interfaces;
+    };
+
+    static std::string key(const fs::path & modulePath);
+    static uint64_t contentHash(const fs::path & modulePath);
+
+    fs::path m_cacheFilePath;
+    mutable std::mutex m_mutex;
+    std::map<std::string, ModuleRecord> m_modules;
+    bool m_modified = false;
+};
+
+}}} //namespace org::bcom::xpcf
+
+#endif // ORG_BCOM_XPCF_MODULEINDEXCACHE_H
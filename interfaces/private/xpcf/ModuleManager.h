@@ -29,21 +29,20 @@
 #include "xpcf/api/ComponentMetadata.h"
 #include <vector>
 #include <atomic>
+#include <functional>
+#include <future>
+#include <map>
 #include <mutex>
 
-#ifdef XPCF_WITH_LOGS
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
-#endif
-
-#include <boost/function.hpp>
-
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
 
 namespace org { namespace bcom { namespace xpcf {
 
+// module library opened and validated once, referenced by the components it created
+class ModuleHandle;
+class ModuleIndexCache;
+
 class ModuleManager : public ComponentBase,
         virtual public IModuleManager {
 public:
@@ -57,29 +56,49 @@ public:
     XPCFErrorCode saveModuleInformations(const char * xmlFilePath,
                                          const SPtr<ModuleMetadata> & moduleInfos) override;
     SRef<IComponentIntrospect> createComponent(SPtr<ModuleMetadata> moduleInfos, const uuids::uuid& componentUUID) override;
+    void enableModulesUnloading(bool enable) override { m_modulesUnloading = enable; }
+    uint32_t getComponentsCount(const uuids::uuid & moduleUUID) const override;
+    void prefetchModule(SPtr<ModuleMetadata> moduleInfos) override;
+    bool isModuleLoaded(const uuids::uuid & moduleUUID) const override;
 
     void unloadComponent () override final;
-    void releaseModuleRef(const uuids::uuid& moduleUUID);
+    // called once a component created from module is unloaded
+    void releaseModuleRef(const SRef<ModuleHandle> & module);
+    /**
+     * Introspects the modules of modulesPaths in parallel, opening each module library once.
+     * The modules metadata are then passed to declareModule sequentially in the modulesPaths order.
+     * When a module introspection fails, the exception is thrown once the previous modules are declared.
+     * The modules found unchanged in cache are not introspected : declareModule then receives their cached metadata.
+     */
+    void introspectModules(const std::vector<fs::path> & modulesPaths,
+                           const std::function<void(const fs::path & modulePath, SPtr<ModuleMetadata> moduleInfos, bool cached)> & declareModule,
+                           ModuleIndexCache * cache = nullptr);
 
 private:
     ModuleManager();
     ~ModuleManager() override = default;
     ModuleManager(const ModuleManager&)= delete;
     ModuleManager& operator=(const ModuleManager&)= delete;
-    void addModuleRef(const uuids::uuid& moduleUUID);
-   // void releaseModuleRef(const uuids::uuid& moduleUUID);
+    SRef<ModuleHandle> moduleHandle(SPtr<ModuleMetadata> moduleInfos);
     bool isXpcfModule(fs::path modulePath);
     SPtr<ModuleMetadata> introspectModule(fs::path modulePath);
+    // reads the metadata and the index of the module, without registering the module
+    SPtr<ModuleMetadata> readModuleMetadata(fs::path modulePath);
+    // returns the metadata already registered for the module UUID if any, otherwise registers moduleInfos
+    SPtr<ModuleMetadata> registerModuleMetadata(SPtr<ModuleMetadata> moduleInfos);
     std::vector<SRef<InterfaceMetadata>> getComponentInterfaceList(SPtr<ModuleMetadata> moduleInfos,
                                                                    const uuids::uuid& componentUUID);
     static std::atomic<ModuleManager*> m_instance;
     static std::mutex m_mutex;
-#ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
-#endif
-
     std::map<uuids::uuid, SPtr<ModuleMetadata>> m_moduleMap;
-    std::map<uuids::uuid, boost::function<XPCFErrorCode(const uuids::uuid &, SRef<IComponentIntrospect>&)>> m_funcMap;
+    std::mutex m_moduleMapMutex;
+    // opened modules, replaced upon each module loading or unloading
+    using ModuleHandleMap = std::map<uuids::uuid, SRef<ModuleHandle>>;
+    SRef<const ModuleHandleMap> m_modules = utils::make_shared<const ModuleHandleMap>();
+    std::mutex m_modulesMutex;
+    // modules whose library is being opened, guarded by m_modulesMutex
+    std::map<uuids::uuid, std::shared_future<SRef<ModuleHandle>>> m_pendingModules;
+    std::atomic<bool> m_modulesUnloading{false};
 };
 
 template <> struct ComponentTraits<ModuleManager>
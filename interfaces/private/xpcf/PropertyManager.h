@@ -30,12 +30,6 @@
 #include "AliasManager.h"
 #include "Registry.h"
 
-#ifdef XPCF_WITH_LOGS
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
-#endif
-
 #include <atomic>
 #include <mutex>
 #include <thread>
@@ -109,9 +103,6 @@ private:
     XPCFErrorCode configure(std::function<bool(tinyxml2::XMLElement *)> xmlNodePredicate, const uuids::uuid & componentUUID, SRef<IConfigurable> componentRef,const char * filepath);
     void declareComponent(tinyxml2::XMLElement * xmlElt, const fs::path & configFilePath);
     void declareConfigure(tinyxml2::XMLElement * xmlElt, const fs::path & configFilePath);
-#ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
-#endif
     SRef<IAliasManager> m_aliasManager;
     SRef<IRegistryManager> m_registry;
     SRef<PropertyContext> m_context;
@@ -31,12 +31,6 @@
 #include <xpcf/component/ComponentBase.h>
 #include "AliasManager.h"
 
-#ifdef XPCF_WITH_LOGS
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
-#endif
-
 #include <boost/filesystem.hpp>
 
 #include <atomic>
@@ -86,6 +80,10 @@ public:
     void clear() override;
 
     XPCFErrorCode loadModules(const char* folderPathStr, bool bRecurse) override;
+    void enableModuleIndexCache(bool enable) override { m_moduleIndexCacheEnabled = enable; }
+    void setModuleIndexCachePath(const char* cacheFilePath) override;
+    XPCFErrorCode buildModuleIndexCache(const char* folderPathStr, bool bRecurse) override;
+    std::vector<std::string> verifyModuleIndexCache(const char* folderPathStr, bool bRecurse) const override;
     XPCFErrorCode loadModuleMetadata(const char* moduleName,
                                      const char* moduleFilePath) override;
     void declareModuleMetadata(SPtr<ModuleMetadata> moduleInfos) override;
@@ -106,22 +104,27 @@ public:
 
 private:
     template <class T> XPCFErrorCode load(fs::path folderPath);
-    template <class T> XPCFErrorCode loadModules(fs::path folderPath);
+    template <class T> std::vector<fs::path> findModules(fs::path folderPath) const;
+    XPCFErrorCode findModules(const char* folderPathStr, bool bRecurse, std::vector<fs::path> & modulesPaths) const;
+    void loadModules(const std::vector<fs::path> & modulesPaths, bool rebuildCache);
+    // the cache file set with setModuleIndexCachePath, or the default one
+    fs::path moduleIndexCachePath() const;
     void addModuleMetadata(SPtr<ModuleMetadata> metadata);
     void addInterfaceMetadata(SPtr<InterfaceMetadata> metadata);
+    // declares a module read from the module index cache, whose components interfaces are already known
+    void declareModuleMetadata(SPtr<ModuleMetadata> moduleInfos, const std::vector<SPtr<InterfaceMetadata>> & interfaces);
+    void declareComponentInterface(SRef<ComponentMetadata> componentInfo, SRef<InterfaceMetadata> interfaceInfo);
     void declareInterfaceNode(SRef<ComponentMetadata> componentInfo, tinyxml2::XMLElement *interfaceElt);
     void declareComponent(SRef<ModuleMetadata> moduleInfo, tinyxml2::XMLElement *componentElt);
     void autobind(const uuids::uuid & interfaceUUID, const uuids::uuid & componentUUID) { m_autobind(interfaceUUID,componentUUID); }
 
-#ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
-#endif
-
     SRef<RegistryContext> m_context;
     std::function<void(const uuids::uuid &, const uuids::uuid &)> m_autobind = [](const uuids::uuid &, const uuids::uuid &) -> void {};
     SRef<IAliasManager> m_aliasManager;
     bool m_libraryLoaded;
     bool m_autoAlias = false;
+    bool m_moduleIndexCacheEnabled = false;
+    fs::path m_moduleIndexCachePath;
 };
 
 
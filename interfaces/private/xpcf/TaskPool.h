@@ -0,0 +1,104 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief task pool used to build independent parts of a component graph concurrently
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_TASKPOOL_H
+#define ORG_BCOM_XPCF_TASKPOOL_H
+
+#include "xpcf/core/refs.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace org { namespace bcom { namespace xpcf {
+
+/**
+ * @class TaskPool
+ * @brief Fixed set of worker threads running the tasks submitted through TaskGroups.
+ *
+ * The pool is created upon first use and lives until the library is unloaded.
+ */
+class TaskPool {
+public:
+    static TaskPool & instance();
+    ~TaskPool();
+    std::size_t size() const { return m_workers.size(); }
+    // runs func on a worker, without waiting for it : func must handle its own errors
+    void post(const std::function<void(void)> & func);
+
+private:
+    friend class TaskGroup;
+
+    class Task {
+    public:
+        Task(const std::function<void(void)> & func):m_func(func), m_done(m_promise.get_future()) {}
+        // runs the task unless another thread already claimed it
+        void run();
+        void wait() { m_done.wait(); }
+        void get() { m_done.get(); }
+
+    private:
+        std::function<void(void)> m_func;
+        std::atomic<bool> m_claimed{false};
+        std::promise<void> m_promise;
+        std::future<void> m_done;
+    };
+
+    TaskPool(std::size_t threadsCount);
+    void submit(const SRef<Task> & task);
+    void work();
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<SRef<Task>> m_tasks;
+    bool m_stop = false;
+    std::vector<std::thread> m_workers;
+};
+
+/**
+ * @class TaskGroup
+ * @brief Set of tasks submitted to a TaskPool and awaited together.
+ *
+ * The thread waiting for the group runs the group tasks not started yet by the pool workers.
+ * Hence a task can itself wait for a nested group without starving the pool.
+ */
+class TaskGroup {
+public:
+    TaskGroup(TaskPool & pool = TaskPool::instance()):m_pool(pool) {}
+    ~TaskGroup();
+    void run(const std::function<void(void)> & func);
+    // waits for every task of the group, then rethrows the first exception raised by a task in submission order
+    void wait();
+
+private:
+    TaskPool & m_pool;
+    std::vector<SRef<TaskPool::Task>> m_tasks;
+};
+
+}}}
+
+#endif // ORG_BCOM_XPCF_TASKPOOL_H
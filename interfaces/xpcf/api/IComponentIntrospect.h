@@ -32,6 +32,8 @@
 //TODO : namespacing normalization
 namespace org { namespace bcom { namespace xpcf {
 
+template <class I> class ComponentRef;
+
 /**
   * @class IComponentIntrospect
   * @brief Specifies the IComponentIntrospect interface.
@@ -43,6 +45,7 @@ namespace org { namespace bcom { namespace xpcf {
 class IComponentIntrospect
 {
     friend class ComponentFactory;
+    template <class I> friend class ComponentRef;
 public:
     /**
      * Virtual destructor of IComponentIntrospect
@@ -98,6 +101,8 @@ public:
     /**
      * Binds the component to the requested interface.
      * This method uses the InterfaceTraits defined for I to retrieve the interface UUID.
+     * The reference returned shares the control block of the other references upon the component :
+     * binding a referenced component to any of its interfaces doesn't allocate.
      * @throws  InterfaceNotImplementedException when the component doesn't implement interface @em interfaceUUID
      * @throws  utils::bad_any_cast when @em interfaceUUID requested is not the UUID of interface @em I
      * @return the shared reference upon the requested interface @em I
@@ -131,10 +136,18 @@ protected:
 
 private:
     /**
-     * @return the smart reference on the IComponentIntrospect interface of the underlying component
+     * @return the smart reference on the IComponentIntrospect interface of the underlying component.
+     * The reference is shared as long as it is alive : the references upon the component interfaces alias it.
      */
     virtual SRef<IComponentIntrospect> introspect() = 0;
 
+    /**
+     * @param  interfaceUUID the interface unique ID
+     * @throws InterfaceNotImplementedException when the component doesn't implement interface @em interfaceUUID
+     * @return the address of the interface @em interfaceUUID within the component
+     */
+    virtual void * interfaceAddress(const uuids::uuid & interfaceUUID) const = 0;
+
     /**
    * Increment the reference counter of the component
    */
@@ -185,10 +198,9 @@ SRef<I> IComponentIntrospect::queryInterface(const uuids::uuid& interfaceUUID)
 {
     static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
                   "Interface type passed to createComponent is not a derived class of IComponentIntrospect !!");
-    SRef<I> componentRef;
     utils::any obj = queryInterface(interfaceUUID);
-    componentRef = IComponentIntrospect::acquireComponentRef<I, I>(utils::any_cast<I*>(obj));
-    return componentRef;
+    I * address = utils::any_cast<I*>(obj);
+    return SRef<I>(introspect(), address);
 }
 
 template <class I>
@@ -197,7 +209,9 @@ SRef<I> IComponentIntrospect::bindTo()
     static_assert(is_interface<I>::value,
                   "Type I passed to bindTo<I> is not an interface"
                   "or InterfaceTraits is not defined for I !!");
-    return queryInterface<I>(toUUID<I>());
+    // the interface UUID comes from I traits : the address is the one of I without any type check through utils::any
+    I * address = static_cast<I *>(interfaceAddress(toUUID<I>()));
+    return SRef<I>(introspect(), address);
 }
 
 template <class I>
@@ -226,6 +226,31 @@ public:
      */
     template < typename I> const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll();
 
+    /**
+     *
+     * @note with @fn IFactory::resolveAsync()
+     * @return a future on the component resolved asynchronously by the inner factory
+     */
+    template <typename I, template <typename> class Promise = std::promise> auto resolveAsync();
+    template <typename I, template <typename> class Promise = std::promise> auto resolveAsync(const char * name);
+    template <typename I, template <typename> class Promise = std::promise> auto resolveAllAsync();
+
+    /**
+     *
+     * @note with @fn IFactory::resolveMany()
+     * @return the resolution outcome of each request resolved in one batch by the inner factory
+     */
+    std::vector<BatchResolution> resolveMany(const std::vector<std::pair<uuids::uuid,std::string>> & requests, bool parallel = false);
+    template <typename... I> std::tuple<SRef<I>...> resolveMany(bool parallel = false);
+
+    /**
+     *
+     * @note with @fn IFactory::tryResolve()
+     * @return the component bound to I, or a result holding the XPCFErrorCode::_ERROR_INJECTABLE_NOBIND error code when I has no bind
+     */
+    template <typename I> result<SRef<I>, XPCFErrorCode> tryResolve();
+    template <typename I> result<SRef<I>, XPCFErrorCode> tryResolve(const char * name);
+
     /**
      *
      * @note with @fn resolve()
@@ -280,6 +305,41 @@ template < typename I> SRef<I> IComponentManager::resolve(const char * name)
     return getFactory()->resolve<I>(name);
 }
 
+template <typename I> result<SRef<I>, XPCFErrorCode> IComponentManager::tryResolve()
+{
+    return getFactory()->tryResolve<I>();
+}
+
+template <typename I> result<SRef<I>, XPCFErrorCode> IComponentManager::tryResolve(const char * name)
+{
+    return getFactory()->tryResolve<I>(name);
+}
+
+inline std::vector<BatchResolution> IComponentManager::resolveMany(const std::vector<std::pair<uuids::uuid,std::string>> & requests, bool parallel)
+{
+    return getFactory()->resolveMany(requests, parallel);
+}
+
+template <typename... I> std::tuple<SRef<I>...> IComponentManager::resolveMany(bool parallel)
+{
+    return getFactory()->resolveMany<I...>(parallel);
+}
+
+template <typename I, template <typename> class Promise> auto IComponentManager::resolveAsync()
+{
+    return getFactory()->resolveAsync<I, Promise>();
+}
+
+template <typename I, template <typename> class Promise> auto IComponentManager::resolveAsync(const char * name)
+{
+    return getFactory()->resolveAsync<I, Promise>(name);
+}
+
+template <typename I, template <typename> class Promise> auto IComponentManager::resolveAllAsync()
+{
+    return getFactory()->resolveAllAsync<I, Promise>();
+}
+
 template < typename I >
 SRef<I> IComponentManager::createComponent(const char * instanceName, const uuids::uuid & componentUUID)
 {
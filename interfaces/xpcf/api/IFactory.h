@@ -26,13 +26,24 @@
 //#define BOOST_ALL_DYN_LINK 1
 #include <xpcf/api/IInjectable.h>
 #include <xpcf/component/ComponentFactory.h>
+#include <xpcf/core/Result.h>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace org { namespace bcom { namespace xpcf {
 
 
 typedef enum {
     Transient,
-    Singleton
+    Singleton,
+    Pooled, // released instances return to a per binding pool and are handed out by further resolutions
+    PerThread, // one instance per thread, kept in the thread local storage of the resolving thread
+    Scoped // one instance per scope created with IFactory::createScope(), released with the scope. Transient outside a scope
 } BindingScope;
 
 
@@ -47,9 +58,56 @@ typedef enum {
 typedef enum {
     Empty,
     Cloned,
-    Shared
+    Shared,
+    Overlay // the new factory only stores its own binds, and falls through to the current binds of the original factory
 } ContextMode;
 
+// runs the task it receives once, on any thread
+using AsyncExecutor = std::function<void(const std::function<void(void)> &)>;
+
+// construction report of a singleton instantiated by IFactory::warmup()
+struct SingletonWarmupInfos {
+    uuids::uuid interfaceUUID;
+    // name of the bind, empty for default binds and multibinds
+    std::string name;
+    uuids::uuid componentUUID;
+    // creation, injection and configuration duration of the singleton
+    std::chrono::microseconds duration;
+};
+
+// returns the number of heap bytes allocated so far by the calling thread (see IFactory::enableFootprintReport)
+using AllocatedBytesCounter = uint64_t (*)(void);
+
+// construction cost of the instances of a component type, reported by IFactory::footprintReport()
+struct ComponentFootprint {
+    uuids::uuid componentUUID;
+    // component name from the registry, empty for components created from a factory method without module
+    std::string name;
+    // sizeof the component type, 0 when its module was built without the footprint support
+    std::size_t instanceSize = 0;
+    // number of instances constructed
+    uint64_t instances = 0;
+    // heap bytes allocated and wall time of each construction phase, summed upon the instances.
+    // The costs of the injected components constructed on the same thread are reported on their own type.
+    uint64_t creationBytes = 0;
+    uint64_t injectionBytes = 0;
+    uint64_t configurationBytes = 0;
+    std::chrono::nanoseconds creationDuration{0};
+    std::chrono::nanoseconds injectionDuration{0};
+    std::chrono::nanoseconds configurationDuration{0};
+};
+
+// outcome of one resolution of a IFactory::resolveMany() batch
+struct BatchResolution {
+    uuids::uuid interfaceUUID;
+    // name of the bind, empty for default binds
+    std::string name;
+    // resolved component, null when the resolution failed
+    SRef<IComponentIntrospect> component;
+    // resolution error (see resolve()), null when the resolution succeeded
+    std::exception_ptr error;
+};
+
 /**
  * @class IFactory
  * @brief Specifies the IFactory interface.
@@ -65,6 +123,87 @@ public:
     virtual void clear() = 0;
     virtual SRef<IFactory> createNewFactoryContext(ContextMode ctxMode = ContextMode::Empty) = 0;
 
+    /**
+     * Create a resolution scope upon this factory.
+     * The scope shares the bindings, configuration and singleton instances of this factory.
+     * Components bound with the BindingScope::Scoped scope are created once per scope : every resolution made within the scope
+     * returns the same instance. All scoped instances are released at once when the scope is released.
+     * A scope can itself create nested scopes.
+     * @return the scope factory
+     */
+    virtual SRef<IFactory> createScope() = 0;
+
+    /**
+     * Enable or disable the parallel injection mode (disabled by default).
+     * When enabled, the injectables of a component are resolved concurrently on the xpcf task pool,
+     * with the same bindings and binding ranges as a sequential injection.
+     * The component's onInjected() is still called once all its injectables are set.
+     * The mode can also be enabled with the parallelInjection="true" attribute of the xml factory element.
+     * Factory contexts created afterwards in Cloned or Shared mode inherit the mode.
+     * @param [in] enable : true to resolve injectables concurrently, false for a sequential injection
+     */
+    virtual void enableParallelInjection(bool enable) = 0;
+    virtual bool parallelInjectionEnabled() const = 0;
+
+    /**
+     * Freeze the bindings of the factory context : bind lookups then use immutable hash tables instead of ordered maps.
+     * Call freeze() once the configuration is loaded.
+     * Binds declared after freeze() are still accepted : they compile the hash tables again, and the context remains frozen.
+     * The mode can also be enabled with the freeze="true" attribute of the xml factory element.
+     */
+    virtual void freeze() = 0;
+    virtual bool frozen() const = 0;
+
+    /**
+     * Set the executor running the asynchronous resolutions (resolveAsync, resolveAllAsync).
+     * By default, asynchronous resolutions run on the xpcf task pool.
+     * Factory contexts and scopes created afterwards inherit the executor.
+     * @param [in] executor : the executor, or nullptr to restore the xpcf task pool
+     */
+    virtual void setAsyncExecutor(const AsyncExecutor & executor) = 0;
+
+    /**
+     * Run task with the asynchronous resolutions executor.
+     * @param [in] task : the task to run. It must handle its own errors.
+     */
+    virtual void executeAsync(const std::function<void(void)> & task) = 0;
+
+    /**
+     * Instantiate every singleton bound in the factory context (default, named and multi binds), instead of upon their first resolution.
+     * Singletons are instantiated concurrently on the xpcf task pool : a singleton injecting another singleton waits for it, or builds it.
+     * The warmup can also be requested with the warmup="true" attribute of the xml root element : it then occurs once the file is loaded.
+     * @return the construction duration of each singleton
+     * @throws ConfigurationException when a singleton resolution fails
+     */
+    virtual std::vector<SingletonWarmupInfos> warmup() = 0;
+
+    /**
+     * Enable or disable the footprint report (disabled by default).
+     * When enabled, each component constructed by the factory (resolutions, replays, createComponent) records its size,
+     * and the heap bytes and wall time of its creation, injection and configuration.
+     * Enabling the report again discards the previous records.
+     * Factory contexts and scopes created afterwards share the report.
+     * @param [in] enable : true to record the components constructions
+     * @param [in] counter : the allocated bytes counter of the application, typically fed by a replacement of the global operator new.
+     * The heap bytes are reported as 0 without counter.
+     */
+    virtual void enableFootprintReport(bool enable, AllocatedBytesCounter counter = nullptr) = 0;
+
+    /**
+     * @return the construction costs recorded since the footprint report was enabled, aggregated per component type
+     */
+    virtual std::vector<ComponentFootprint> footprintReport() const = 0;
+
+    /**
+     * Resolve a batch of components in one call.
+     * Every request is resolved upon the same bindings snapshot, and the requests sharing an instance
+     * (singletons, scoped instances) are resolved once.
+     * A failed resolution doesn't abort the batch : its error is reported in its BatchResolution.
+     * @param [in] requests : the [interface uuid, bind name] of each component to resolve, with an empty name for the default bind
+     * @param [in] parallel : true to resolve the requests concurrently on the xpcf task pool
+     * @return the resolution outcome of each request, in the requests order
+     */
+    virtual std::vector<BatchResolution> resolveMany(const std::vector<std::pair<uuids::uuid,std::string>> & requests, bool parallel = false) = 0;
 
     /**
      *
@@ -165,6 +304,23 @@ public:
      * or when the component resolved for {I, name} declares injectable(s) and there was missing bind(s) to resolve them
      */
     virtual SRef<IComponentIntrospect> resolve(const uuids::uuid & interfaceUUID, const std::string & name) = 0;
+
+    /**
+     * Resolve the component bound to an interface, without raising an exception when the interface has no bind
+     * @param [in] interfaceUUID : the interface uuid
+     * @return the component, or a result holding the XPCFErrorCode::_ERROR_INJECTABLE_NOBIND error code when no bind was found
+     * @throws ConfigurationException when the component is bound but its resolution fails (for instance a missing bind for one of its injectables)
+     */
+    virtual result<SRef<IComponentIntrospect>, XPCFErrorCode> tryResolve(const uuids::uuid & interfaceUUID) = 0;
+
+    /**
+     * Resolve the component bound to an interface with a name, without raising an exception when the interface has no bind
+     * @param [in] interfaceUUID : the interface uuid
+     * @param [in] name : the bind name
+     * @return the component, or a result holding the XPCFErrorCode::_ERROR_INJECTABLE_NOBIND error code when no bind was found
+     * @throws ConfigurationException when the component is bound but its resolution fails (for instance a missing bind for one of its injectables)
+     */
+    virtual result<SRef<IComponentIntrospect>, XPCFErrorCode> tryResolve(const uuids::uuid & interfaceUUID, const std::string & name) = 0;
     virtual const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const SPtr<InjectableMetadata> & injectableInfo) = 0;
     virtual const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll(const uuids::uuid & interfaceUUID) = 0;
     virtual uuids::uuid getComponentUUID(const uuids::uuid & interfaceUUID) = 0;
@@ -208,6 +364,34 @@ public:
     template <typename I> SRef<I> resolve();
     template <typename I> SRef<I> resolve(const std::string & name);
     template < typename I> const SRef<IEnumerable<SRef<IComponentIntrospect>>> resolveAll();
+
+    /**
+     * @note with @fn tryResolve(const uuids::uuid &)
+     * @return the component bound to I, or a result holding the XPCFErrorCode::_ERROR_INJECTABLE_NOBIND error code when I has no bind
+     */
+    template <typename I> result<SRef<I>, XPCFErrorCode> tryResolve();
+    template <typename I> result<SRef<I>, XPCFErrorCode> tryResolve(const std::string & name);
+
+    /**
+     * Resolve the components bound to each interface I in one batch
+     * @note with @fn resolveMany(const std::vector<std::pair<uuids::uuid,std::string>> &, bool)
+     * @param [in] parallel : true to resolve the components concurrently on the xpcf task pool
+     * @return the components, in the interfaces order
+     * @throws the first resolution error of the batch, once every resolution is over
+     */
+    template <typename... I> std::tuple<SRef<I>...> resolveMany(bool parallel = false);
+
+    /**
+     * Resolve the component bound to I asynchronously : the creation, injection and configuration of the component
+     * run with the executor set with setAsyncExecutor(), and the calling thread is never blocked.
+     * Concurrent resolutions of a singleton still create a single instance.
+     * @tparam Promise : the promise providing the returned future. Use utils::fibers::promise (from boost/fiber/future.hpp)
+     * to await the resolution from a fiber (see FiberTask) without blocking the fiber thread.
+     * @return a future on the component, that rethrows the resolution errors (see resolve())
+     */
+    template <typename I, template <typename> class Promise = std::promise> auto resolveAsync();
+    template <typename I, template <typename> class Promise = std::promise> auto resolveAsync(const std::string & name);
+    template <typename I, template <typename> class Promise = std::promise> auto resolveAllAsync();
     template < typename I, BindingScope scope = BindingScope::Transient,
                uint8_t bindingRangeMask = BindingRange::Default|BindingRange::All > void bind(const uuids::uuid& componentUUID);
 
@@ -288,6 +472,88 @@ const SRef<IEnumerable<SRef<IComponentIntrospect>>> IFactory::resolveAll()
     return resolveAll(toUUID<I>());
 }
 
+// converts a component result to a result upon the interface I of the component
+template <typename I>
+result<SRef<I>, XPCFErrorCode> interfaceResult(const result<SRef<IComponentIntrospect>, XPCFErrorCode> & componentResult)
+{
+    if (componentResult.hasError()) {
+        return result<SRef<I>, XPCFErrorCode>(SRef<I>(), componentResult.errContext(), componentResult.errCode());
+    }
+    return result<SRef<I>, XPCFErrorCode>(componentResult.getValue()->template bindTo<I>(), "", XPCFErrorCode::_SUCCESS);
+}
+
+template <typename I>
+result<SRef<I>, XPCFErrorCode> IFactory::tryResolve()
+{
+    return interfaceResult<I>(tryResolve(toUUID<I>()));
+}
+
+template <typename I>
+result<SRef<I>, XPCFErrorCode> IFactory::tryResolve(const std::string & name)
+{
+    return interfaceResult<I>(tryResolve(toUUID<I>(), name));
+}
+
+// binds the component of each batch resolution to the interface at the same position in I
+template <typename... I, std::size_t... Is>
+std::tuple<SRef<I>...> batchInterfaces(const std::vector<BatchResolution> & batch, std::index_sequence<Is...>)
+{
+    return std::tuple<SRef<I>...>{batch[Is].component->template bindTo<I>()...};
+}
+
+template <typename... I>
+std::tuple<SRef<I>...> IFactory::resolveMany(bool parallel)
+{
+    std::vector<BatchResolution> batch = resolveMany({std::make_pair(toUUID<I>(), std::string())...}, parallel);
+    for (auto & resolution : batch) {
+        if (resolution.error) {
+            std::rethrow_exception(resolution.error);
+        }
+    }
+    return batchInterfaces<I...>(batch, std::index_sequence_for<I...>{});
+}
+
+// runs resolveFunc upon factory with the factory executor, and provides its result through a future built from Promise
+template <template <typename> class Promise, typename T>
+auto runAsync(SRef<IFactory> factory, const std::function<T(SRef<IFactory>)> & resolveFunc)
+{
+    SRef<Promise<T>> promise = utils::make_shared<Promise<T>>();
+    auto future = promise->get_future();
+    factory->executeAsync([factory, promise, resolveFunc]() {
+        try {
+            promise->set_value(resolveFunc(factory));
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+template <typename I, template <typename> class Promise>
+auto IFactory::resolveAsync()
+{
+    return runAsync<Promise, SRef<I>>(bindTo<IFactory>(), [](SRef<IFactory> factory) {
+        return factory->resolve<I>();
+    });
+}
+
+template <typename I, template <typename> class Promise>
+auto IFactory::resolveAsync(const std::string & name)
+{
+    return runAsync<Promise, SRef<I>>(bindTo<IFactory>(), [name](SRef<IFactory> factory) {
+        return factory->resolve<I>(name);
+    });
+}
+
+template <typename I, template <typename> class Promise>
+auto IFactory::resolveAllAsync()
+{
+    return runAsync<Promise, SRef<IEnumerable<SRef<IComponentIntrospect>>>>(bindTo<IFactory>(), [](SRef<IFactory> factory) {
+        return factory->resolveAll<I>();
+    });
+}
+
 template < typename I, BindingScope scope,
            uint8_t bindingRangeMask> void  IFactory::bind(const uuids::uuid & componentUUID)
 {
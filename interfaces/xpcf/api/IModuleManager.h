@@ -51,7 +51,7 @@ public:
      */
     virtual ~IModuleManager() = default;
 
-
+    // the module checks and introspection below open the module library : loading a configuration file doesn't use them
     virtual bool isXpcfModule(const char* modulePath) = 0;
     virtual bool isXpcfModule(const char* moduleName, const char* moduleFolderPath) = 0;
     virtual bool isXpcfModule(SPtr<ModuleMetadata> moduleInfos) = 0;
@@ -90,6 +90,35 @@ public:
     virtual SRef<IComponentIntrospect> createComponent(SPtr<ModuleMetadata> moduleInfos,
                                        const uuids::uuid& componentUUID) = 0;
 
+    /**
+     * Enable or disable the modules unloading (disabled by default).
+     * A module library is opened and validated once, upon its first component creation.
+     * When unloading is enabled, the module is unloaded once every component it created is released :
+     * a further creation opens it again.
+     * @param [in] enable : true to unload the modules without live components
+     */
+    virtual void enableModulesUnloading(bool enable) = 0;
+
+    /**
+     * @param [in] moduleUUID : the module unique identifier
+     * @return the number of live components created from the module, 0 when the module isn't loaded
+     */
+    virtual uint32_t getComponentsCount(const uuids::uuid & moduleUUID) const = 0;
+
+    /**
+     * Open a module library in the background, on the xpcf task pool, so that its first component creation doesn't wait for it.
+     * The modules declared in a configuration file are registered from the file only : their library is opened upon the first
+     * component creation, or upon a prefetch. A module failing to load is reported by its first component creation.
+     * @param [in] moduleInfos : the module to load
+     */
+    virtual void prefetchModule(SPtr<ModuleMetadata> moduleInfos) = 0;
+
+    /**
+     * @param [in] moduleUUID : the module unique identifier
+     * @return true when the module library is opened
+     */
+    virtual bool isModuleLoaded(const uuids::uuid & moduleUUID) const = 0;
+
 };
 
 template <> struct InterfaceTraits<IModuleManager>
@@ -29,6 +29,9 @@
 #include <xpcf/api/ModuleMetadata.h>
 #include <xpcf/core/XPCFErrorCode.h>
 
+#include <string>
+#include <vector>
+
 namespace org { namespace bcom { namespace xpcf {
 
 /**
@@ -58,6 +61,38 @@ public:
      */
     virtual XPCFErrorCode loadModules(const char* folderPathStr, bool bRecurse = false) = 0;
 
+    /**
+     * Enables the module index cache used by loadModules. The cache is disabled by default.
+     * The cache file stores the metadata of the modules introspected, keyed by module file path,
+     * size, modification time and content hash : an unchanged module is declared from the cache without loading its library.
+     * @param [in] enable : true to enable the cache, false to introspect every module
+     */
+    virtual void enableModuleIndexCache(bool enable) = 0;
+
+    /**
+     * Sets the module index cache file used by loadModules, buildModuleIndexCache and verifyModuleIndexCache.
+     * @param [in] cacheFilePath : the cache file path, or an empty path for the default cache file ~/.xpcf/modules.cache
+     */
+    virtual void setModuleIndexCachePath(const char* cacheFilePath) = 0;
+
+    /**
+     * Load the modules found from a root folder as loadModules does, introspecting every module
+     * and replacing its entry in the module index cache. The entries of the removed module files are discarded.
+     * @param [in] folderPathStr : the root path to search module files' for
+     * @param [in] bRecurse : indicates to search recursively in subfolder [true] or only in @p folderPathStr [false]
+     * @return
+     */
+    virtual XPCFErrorCode buildModuleIndexCache(const char* folderPathStr, bool bRecurse = false) = 0;
+
+    /**
+     * Check the module index cache entries of the module files found from a root folder,
+     * against each module file size and content hash.
+     * @param [in] folderPathStr : the root path to search module files' for
+     * @param [in] bRecurse : indicates to search recursively in subfolder [true] or only in @p folderPathStr [false]
+     * @return the paths of the module files whose cache entry is missing or outdated
+     */
+    virtual std::vector<std::string> verifyModuleIndexCache(const char* folderPathStr, bool bRecurse = false) const = 0;
+
     /**
      * Retrieve every module metadata registered in the ComponentManager
      * @return the collection of modules metadata
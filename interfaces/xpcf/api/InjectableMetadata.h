@@ -25,10 +25,14 @@
 
 #include "IComponentIntrospect.h"
 #include <xpcf/core/uuid.h>
+#include <cstddef>
+#include <functional>
 #include <string>
 
 namespace org { namespace bcom { namespace xpcf {
 
+class IInjectable;
+
 /**
  * @class InjectableMetadata
  * @brief Specifies the InjectableMetadata class.
@@ -52,22 +56,47 @@ private:
 };
 
 
+/**
+ * A LazyResolver resolves the component bound to a lazy injectable upon its first use.
+ */
+using LazyResolver = std::function<SRef<IComponentIntrospect>(void)>;
+
 /**
  * @class Injector
  * @brief Specifies the Injector class.
  *
+ * An injector describes an injectable declared by a component type : it is shared by the instances of the type.
+ * The injectable member of an instance is located from its offset to the IInjectable subobject of the instance,
+ * and the injector setter assigns it.
  */
 class XPCF_EXPORT_API Injector : public InjectableMetadata {
 public:
-    Injector( const std::function<void(SRef<IComponentIntrospect>)> & injector, uuids::uuid serviceUUID, bool optional = false);
-    Injector( const std::function<void(SRef<IComponentIntrospect>)> & injector, uuids::uuid serviceUUID, const char * name, bool optional = false);
-    Injector( const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector, uuids::uuid serviceUUID, bool optional = false);
-    Injector( const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector, uuids::uuid serviceUUID, const char * name, bool optional = false);
+    // setters receive the address of the injectable member
+    using Setter = void (*)(void * injectable, SRef<IComponentIntrospect> instance);
+    using MultiSetter = void (*)(void * injectable, SRef<IEnumerable<SRef<IComponentIntrospect>>> instance);
+    using LazySetter = void (*)(void * injectable, const LazyResolver & resolver);
+
+    Injector(Setter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, bool optional = false);
+    Injector(Setter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, const char * name, bool optional = false);
+    Injector(MultiSetter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, bool optional = false);
+    Injector(LazySetter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, bool optional = false);
+    Injector(LazySetter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, const char * name, bool optional = false);
     virtual ~Injector() override;
-    void inject(SRef<IComponentIntrospect> instance);
-    void inject(SRef<IEnumerable<SRef<IComponentIntrospect>>> instance);
+    void inject(IInjectable & component, SRef<IComponentIntrospect> instance) const;
+    void inject(IInjectable & component, SRef<IEnumerable<SRef<IComponentIntrospect>>> instance) const;
+    void inject(IInjectable & component, const LazyResolver & resolver) const;
     bool isMulti();
+    bool isLazy();
+
+    /**
+     * @return the address of the injectable member of @em component
+     */
+    void * injectable(IInjectable & component) const;
 
+    /**
+     * @return the injectable member offset from the IInjectable subobject of the component
+     */
+    std::ptrdiff_t offset() const;
 
 private:
     class InjectorImpl;
@@ -25,13 +25,21 @@
 
 #include "xpcf/component/ComponentFactory.h"
 #include "xpcf/api/IInjectable.h"
+#include "xpcf/component/ComponentRef.h"
+#include "xpcf/component/Lazy.h"
 #include "xpcf/xpcf_api_define.h"
 #include <xpcf/collection/Collection.h>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <map>
 
 namespace org { namespace bcom { namespace xpcf {
 
+class Factory;
+class ModuleManager;
+class ModuleHandle;
+
 class XPCF_EXPORT_API ComponentBase : virtual public IInjectable
 {
     // friend class ComponentFactory;
@@ -53,6 +61,14 @@ public:
     const InterfaceMetadata & getMetadata(const uuids::uuid& interfaceUUID) const final;
 
     virtual void onInjected() override;
+
+    /**
+     * onRecycled is called when a component bound with the BindingScope::Pooled scope is released by its last user,
+     * before it returns to its pool. It can be overriden to reset the component state before its next resolution.
+     * The component keeps its injectables and its configuration.
+     */
+    virtual void onRecycled();
+
     // It is the component that decides if it must or must not unload when all
     // refs are out
     virtual void unloadComponent() = 0;
@@ -93,15 +109,55 @@ protected:
 
     template <typename I> void declareInjectable(SRef<ICollection<SRef<I>>> & injectable, bool optional = false);
 
+    /**
+     * Declare a lazy injectable : the component bound to I is only resolved upon the first dereference of @p injectable.
+     * The resolution uses the bindings and the binding context in effect when the component was injected.
+     * @param [in] injectable : the lazy handle to inject
+     * @param [in] optional : when true, the injection doesn't fail when no component is bound to I
+     * @throws InjectableDeclarationException when another injectable has already been declared for I
+     */
+    template <typename I> void declareLazyInjectable(Lazy<I> & injectable, bool optional = false);
+
+    /**
+     * Declare a named lazy injectable : the component bound to {I, name} is only resolved upon the first dereference of @p injectable.
+     * @throws InjectableDeclarationException when another injectable has already been declared for {I, name}
+     */
+    template <typename I> void declareLazyInjectable(Lazy<I> & injectable, const char * name, bool optional = false);
+
 private:
+    friend class Factory;
+    friend class ModuleManager;
+    friend class ComponentPool;
+    void setRecycler(const std::function<bool(ComponentBase *)> & recycler);
+    // records the module the component was created from : it stays loaded until the component is unloaded.
+    // Returns false when the component already belongs to a module
+    bool setModule(const SRef<ModuleHandle> & module);
+    bool recycle();
+    // unloads the component, then releases the module it was created from
+    void unload();
     SRef<IComponentIntrospect> introspect() final;
+    // the reference aliased by the interfaces references, without creating it : empty while no reference upon the component is alive
+    utils::weak_ptr<IComponentIntrospect> selfReference();
     void addComponentRef() final;
     void releaseComponentRef() final;
-    void declareInterface(const uuids::uuid& interfaceUUID, utils::any componentThis, const char * name, const char * description);
-    void declareInjectable(const uuids::uuid& interfaceUUID, utils::any injectable, const std::function<void(SRef<IComponentIntrospect>)> & injector, const char * instanceName, bool optional = false);
-    void declareInjectable(const uuids::uuid& interfaceUUID, utils::any injectable, const std::function<void(SRef<IComponentIntrospect>)> & injector, bool optional = false);
-    void declareMultiInjectable(const uuids::uuid& interfaceUUID, utils::any injectable, const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector, bool optional = false);
+    // the interface address is recorded as an offset from the ComponentBase subobject, and cast provides the utils::any upon the interface
+    void declareInterface(const uuids::uuid& interfaceUUID, std::ptrdiff_t offset, utils::any (*cast)(void *), const char * name, const char * description);
+    template <class T> static utils::any interfaceCast(void * address) { return utils::any(static_cast<T *>(address)); }
+    // injectables declarations are recorded once per component type : the injectable address is an offset from the IInjectable subobject,
+    // the setter assigns the injectable and retrieve provides the utils::any upon it
+    std::ptrdiff_t injectableOffset(const void * injectable) const;
+    void declareInjectable(const uuids::uuid& interfaceUUID, std::ptrdiff_t offset, Injector::Setter setter, utils::any (*retrieve)(void *), const char * instanceName, bool optional);
+    void declareInjectable(const uuids::uuid& interfaceUUID, std::ptrdiff_t offset, Injector::Setter setter, utils::any (*retrieve)(void *), bool optional);
+    void declareMultiInjectable(const uuids::uuid& interfaceUUID, std::ptrdiff_t offset, Injector::MultiSetter setter, utils::any (*retrieve)(void *), bool optional);
+    void declareLazyInjectable(const uuids::uuid& interfaceUUID, std::ptrdiff_t offset, Injector::LazySetter setter, utils::any (*retrieve)(void *), const char * instanceName, bool optional);
+    void declareLazyInjectable(const uuids::uuid& interfaceUUID, std::ptrdiff_t offset, Injector::LazySetter setter, utils::any (*retrieve)(void *), bool optional);
+    template <class I> static void injectableSetter(void * injectable, SRef<IComponentIntrospect> instance);
+    template <class I> static void multiInjectableSetter(void * injectable, SRef<IEnumerable<SRef<IComponentIntrospect>>> instances);
+    template <class I> static void lazyInjectableSetter(void * injectable, const LazyResolver & resolver) { static_cast<Lazy<I> *>(injectable)->inject(resolver); }
+    template <class T> static utils::any injectableAddress(void * injectable) { return utils::any(static_cast<T *>(injectable)); }
+    template <class T> static utils::any injectableValue(void * injectable) { return utils::any(*static_cast<T *>(injectable)); }
     utils::any queryInterface(const uuids::uuid& interfaceUUID) const final;
+    void * interfaceAddress(const uuids::uuid& interfaceUUID) const final;
     utils::any retrieveInjectable(const uuids::uuid & interfaceUUID) const final;
     utils::any retrieveInjectable(const uuids::uuid &  interfaceUUID, const char * instanceName) const final;
     utils::any retrieveMultiInjectable(const uuids::uuid & interfaceUUID) final;
@@ -116,7 +172,7 @@ private:
     std::map<std::string,std::string> m_componentTrait;
 
     const uuids::uuid m_UUID;
-    uint32_t m_usageRefCount;
+    std::atomic<uint32_t> m_usageRefCount;
 };
 
 
@@ -130,8 +186,9 @@ void ComponentBase::declareInterface(T* componentThis)
     static_assert(utils::is_base_of<IComponentIntrospect, T>::value,
                   "Interface type passed to addInterface is not a derived class of IComponentIntrospect !!");
 
-    uuids::uuid interfaceId = toUUID<T>();
-    declareInterface(interfaceId, componentThis, InterfaceTraits<T>::NAME, InterfaceTraits<T>::DESCRIPTION);
+    // the offset is the same for every instance of a component type : the interfaces table is shared between them
+    std::ptrdiff_t offset = reinterpret_cast<char *>(componentThis) - reinterpret_cast<char *>(this);
+    declareInterface(toUUID<T>(), offset, &ComponentBase::interfaceCast<T>, InterfaceTraits<T>::NAME, InterfaceTraits<T>::DESCRIPTION);
 }
 
 template <class T>
@@ -141,6 +198,29 @@ void ComponentBase::addInterface(T* componentThis)
 }
 
 
+inline std::ptrdiff_t ComponentBase::injectableOffset(const void * injectable) const
+{
+    return reinterpret_cast<const char *>(injectable) - reinterpret_cast<const char *>(static_cast<const IInjectable *>(this));
+}
+
+template <class I>
+void ComponentBase::injectableSetter(void * injectable, SRef<IComponentIntrospect> instance)
+{
+    *static_cast<SRef<I> *>(injectable) = instance->bindTo<I>();
+}
+
+template <class I>
+void ComponentBase::multiInjectableSetter(void * injectable, SRef<IEnumerable<SRef<IComponentIntrospect>>> instances)
+{
+    SRef<ICollection<SRef<I>>> & injectableSet = *static_cast<SRef<ICollection<SRef<I>>> *>(injectable);
+    if (injectableSet->size() > instances->size()) {
+        return;
+    }
+    for (auto instance : *instances) {
+        injectableSet->add(instance->bindTo<I>());
+    }
+}
+
 template <typename I>
 void ComponentBase::declareInjectable(SRef<I> & injectable, bool optional)
 {
@@ -150,9 +230,8 @@ void ComponentBase::declareInjectable(SRef<I> & injectable, bool optional)
 
     static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
                   "Interface type passed to declareInjectable is not a derived class of IComponentIntrospect !!");
-    uuids::uuid interfaceId = toUUID<I>();
-    std::function<void(SRef<IComponentIntrospect>)> injector = [this] (SRef<IComponentIntrospect> instance) { inject<I>(instance); };
-    declareInjectable(interfaceId, &injectable, injector, optional);
+    declareInjectable(toUUID<I>(), injectableOffset(&injectable), &ComponentBase::injectableSetter<I>,
+                      &ComponentBase::injectableAddress<SRef<I>>, optional);
 }
 
 template <typename I>
@@ -164,10 +243,9 @@ void ComponentBase::declareInjectable(SRef<ICollection<SRef<I>>> & injectable, b
 
     static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
                   "Interface type passed to declareInjectable is not a derived class of IComponentIntrospect !!");
-    uuids::uuid interfaceId = toUUID<I>();
     injectable = utils::make_shared<VectorCollection<SRef<I>>>();
-    std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> injector = [this] (SRef<IEnumerable<SRef<IComponentIntrospect>>> instance) { inject<I>(instance); };
-    declareMultiInjectable(interfaceId, injectable, injector, optional);
+    declareMultiInjectable(toUUID<I>(), injectableOffset(&injectable), &ComponentBase::multiInjectableSetter<I>,
+                           &ComponentBase::injectableValue<SRef<ICollection<SRef<I>>>>, optional);
 }
 
 
@@ -180,11 +258,34 @@ void ComponentBase::declareInjectable(SRef<I> & injectable, const char * instanc
 
     static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
                   "Interface type passed to declareInjectable is not a derived class of IComponentIntrospect !!");
-    uuids::uuid interfaceId = toUUID<I>();
-    const std::string name(instanceName);
-    std::function<void(SRef<IComponentIntrospect>)> injector = [this, name] (SRef<IComponentIntrospect> instance) {
-        inject<I>(instance, name.c_str()); };
-    declareInjectable(interfaceId, &injectable, injector, instanceName, optional);
+    declareInjectable(toUUID<I>(), injectableOffset(&injectable), &ComponentBase::injectableSetter<I>,
+                      &ComponentBase::injectableAddress<SRef<I>>, instanceName, optional);
+}
+
+template <typename I>
+void ComponentBase::declareLazyInjectable(Lazy<I> & injectable, bool optional)
+{
+    static_assert(is_interface<I>::value,
+                  "Type passed to declareLazyInjectable is not an interface "
+                  "or InterfaceTraits not defined !!");
+
+    static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
+                  "Interface type passed to declareLazyInjectable is not a derived class of IComponentIntrospect !!");
+    declareLazyInjectable(toUUID<I>(), injectableOffset(&injectable), &ComponentBase::lazyInjectableSetter<I>,
+                          &ComponentBase::injectableAddress<Lazy<I>>, optional);
+}
+
+template <typename I>
+void ComponentBase::declareLazyInjectable(Lazy<I> & injectable, const char * instanceName, bool optional)
+{
+    static_assert(is_interface<I>::value,
+                  "Type passed to declareLazyInjectable is not an interface "
+                  "or InterfaceTraits not defined !!");
+
+    static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
+                  "Interface type passed to declareLazyInjectable is not a derived class of IComponentIntrospect !!");
+    declareLazyInjectable(toUUID<I>(), injectableOffset(&injectable), &ComponentBase::lazyInjectableSetter<I>,
+                          &ComponentBase::injectableAddress<Lazy<I>>, instanceName, optional);
 }
 
 }}} //namespace org::bcom::xpcf
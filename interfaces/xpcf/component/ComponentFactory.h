@@ -24,6 +24,10 @@
 #define ORG_BCOM_XPCF_COMPONENTFACTORY_H
 
 #include "xpcf/api/IComponentIntrospect.h"
+#include "xpcf/xpcf_api_define.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 // NOTE : ALL COMPONENTS MUST THROW EXCEPTIONS DERIVED from std::exception,
 // in order to be able to catch all exceptions in a uniform way
 
@@ -64,6 +68,17 @@ public:
      * @return a pointer on the component created
      */
     template <typename T> static T* createInstance();
+
+    /**
+     * Reports the size of the component type created by the calling thread to the factory footprint report being recorded, if any.
+     * @see IFactory::enableFootprintReport
+     */
+    XPCF_EXPORT_API static void recordInstanceSize(std::size_t size);
+
+private:
+    friend class FootprintScope;
+    // number of the component constructions measured in the process : creations skip recordInstanceSize when it is zero
+    XPCF_EXPORT_API static std::atomic<uint32_t> m_footprintScopesCount;
 };
 
 //can throw std::bad_alloc
@@ -74,7 +89,11 @@ SRef<IComponentIntrospect> ComponentFactory::create()
                   "Type passed to createComponent is not a derived class of IComponentIntrospect !!");
 
     C* component = ComponentFactory::createInstance<C>();
-    return IComponentIntrospect::acquireComponentRef<C, IComponentIntrospect>(component);
+    if (m_footprintScopesCount.load(std::memory_order_relaxed) != 0) {
+        recordInstanceSize(sizeof(C));
+    }
+    // the component reference is the one aliased by its further interfaces references
+    return static_cast<IComponentIntrospect *>(component)->introspect();
 }
 
 
@@ -0,0 +1,141 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief intrusive component reference
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_COMPONENTREF_H
+#define ORG_BCOM_XPCF_COMPONENTREF_H
+
+#include "xpcf/api/IComponentIntrospect.h"
+#include <cstddef>
+#include <utility>
+
+namespace org { namespace bcom { namespace xpcf {
+
+/**
+ * @class ComponentRef
+ * @brief Intrusive reference upon the interface I of a component.
+ *
+ * A ComponentRef holds a single pointer : it increments and decrements the atomic reference counter of the component itself,
+ * without any shared reference control block.
+ * The counter is shared with the SRef references upon the component : the component is released
+ * once every ComponentRef and every SRef upon it are destroyed, whatever the threads releasing them.
+ * A ComponentRef is as thread safe as a raw pointer copy : distinct ComponentRef instances can be copied
+ * and destroyed concurrently, a single instance must not be modified concurrently.
+ */
+template <class I>
+class ComponentRef {
+public:
+    ComponentRef() = default;
+    ComponentRef(std::nullptr_t) {}
+
+    /**
+     * Adds a reference to the component referenced by @em ref
+     */
+    explicit ComponentRef(const SRef<I> & ref):ComponentRef(ref.get()) {}
+
+    ComponentRef(const ComponentRef & other):ComponentRef(other.m_interface) {}
+    ComponentRef(ComponentRef && other) noexcept:m_interface(other.m_interface) { other.m_interface = nullptr; }
+    ~ComponentRef() { reset(); }
+
+    ComponentRef & operator=(const ComponentRef & other) { ComponentRef(other).swap(*this); return *this; }
+    ComponentRef & operator=(ComponentRef && other) noexcept { ComponentRef(std::move(other)).swap(*this); return *this; }
+    ComponentRef & operator=(std::nullptr_t) { reset(); return *this; }
+
+    I * get() const { return m_interface; }
+    I * operator->() const { return m_interface; }
+    I & operator*() const { return *m_interface; }
+    explicit operator bool() const { return m_interface != nullptr; }
+
+    void reset();
+    void swap(ComponentRef & other) noexcept { std::swap(m_interface, other.m_interface); }
+
+    /**
+     * Binds the referenced component to the interface J, without allocation.
+     * @throws  InterfaceNotImplementedException when the component doesn't implement J
+     * @return the intrusive reference upon the interface J of the component
+     */
+    template <class J> ComponentRef<J> bindTo() const;
+
+    /**
+     * @return a shared reference upon the component interface I, aliasing the other shared references upon the component
+     */
+    SRef<I> toSRef() const;
+
+private:
+    template <class J> friend class ComponentRef;
+    explicit ComponentRef(I * component);
+
+    I * m_interface = nullptr;
+};
+
+template <class I>
+ComponentRef<I>::ComponentRef(I * component):m_interface(component)
+{
+    static_assert(utils::is_base_of<IComponentIntrospect, I>::value,
+                  "Type I passed to ComponentRef<I> is not a derived class of IComponentIntrospect !!");
+    if (m_interface) {
+        static_cast<IComponentIntrospect *>(m_interface)->addComponentRef();
+    }
+}
+
+template <class I>
+void ComponentRef<I>::reset()
+{
+    if (m_interface) {
+        // the component can be released by this call : the pointer is cleared first
+        IComponentIntrospect * component = m_interface;
+        m_interface = nullptr;
+        component->releaseComponentRef();
+    }
+}
+
+template <class I>
+template <class J>
+ComponentRef<J> ComponentRef<I>::bindTo() const
+{
+    static_assert(is_interface<J>::value,
+                  "Type J passed to bindTo<J> is not an interface"
+                  "or InterfaceTraits is not defined for J !!");
+    if (!m_interface) {
+        return ComponentRef<J>();
+    }
+    const IComponentIntrospect * component = m_interface;
+    return ComponentRef<J>(static_cast<J *>(component->interfaceAddress(toUUID<J>())));
+}
+
+template <class I>
+SRef<I> ComponentRef<I>::toSRef() const
+{
+    if (!m_interface) {
+        return SRef<I>();
+    }
+    return SRef<I>(static_cast<IComponentIntrospect *>(m_interface)->introspect(), m_interface);
+}
+
+template <class I>
+bool operator==(const ComponentRef<I> & left, const ComponentRef<I> & right) { return left.get() == right.get(); }
+
+template <class I>
+bool operator!=(const ComponentRef<I> & left, const ComponentRef<I> & right) { return left.get() != right.get(); }
+
+}}} //namespace org::bcom::xpcf
+
+#endif // ORG_BCOM_XPCF_COMPONENTREF_H
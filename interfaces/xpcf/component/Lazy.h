@@ -0,0 +1,104 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief lazy injectable handle
+ * @date 2026-10-17
+ */
+
+#ifndef ORG_BCOM_XPCF_LAZY_H
+#define ORG_BCOM_XPCF_LAZY_H
+
+#include "xpcf/api/InjectableMetadata.h"
+#include "xpcf/core/Exception.h"
+#include <atomic>
+#include <mutex>
+
+namespace org { namespace bcom { namespace xpcf {
+
+/**
+ * @class Lazy
+ * @brief Handle upon a lazy injectable of interface I.
+ *
+ * A lazy injectable is declared with ComponentBase::declareLazyInjectable.
+ * Upon injection, the factory only provides the handle with a resolver : the component bound to I
+ * is resolved, injected and configured upon the first dereference of the handle.
+ * The first dereference is thread safe : concurrent first uses resolve the component once.
+ */
+template <class I>
+class Lazy {
+public:
+    Lazy() = default;
+    Lazy(const Lazy &) = delete;
+    Lazy & operator=(const Lazy &) = delete;
+
+    /**
+     * @return the component bound to I, resolved upon the first call
+     * @throws InjectableNotFoundException when no component is bound to an optional lazy injectable
+     * @throws ConfigurationException when the component resolution fails. The resolution is attempted again upon next call.
+     */
+    SRef<I> get() const;
+    I * operator->() const { return get().get(); }
+    I & operator*() const { return *get(); }
+
+    /**
+     * @return true when a component is bound to the injectable, without resolving it
+     */
+    explicit operator bool() const { return m_resolver != nullptr; }
+
+    /**
+     * @return true when the component has already been resolved
+     */
+    bool resolved() const { return m_resolved.load(std::memory_order_acquire); }
+
+    void inject(const LazyResolver & resolver);
+
+private:
+    LazyResolver m_resolver;
+    mutable std::atomic<bool> m_resolved{false};
+    mutable std::mutex m_mutex;
+    mutable SRef<I> m_instance;
+};
+
+template <class I>
+SRef<I> Lazy<I>::get() const
+{
+    if (!m_resolved.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_resolved.load(std::memory_order_relaxed)) {
+            if (!m_resolver) {
+                throw InjectableNotFoundException("No binding found to resolve lazy injectable of interface " + std::string(InterfaceTraits<I>::NAME));
+            }
+            m_instance = m_resolver()->template bindTo<I>();
+            m_resolved.store(true, std::memory_order_release);
+        }
+    }
+    return m_instance;
+}
+
+template <class I>
+void Lazy<I>::inject(const LazyResolver & resolver)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_resolver = resolver;
+    m_instance.reset();
+    m_resolved.store(false, std::memory_order_release);
+}
+
+}}} //namespace org::bcom::xpcf
+
+#endif // ORG_BCOM_XPCF_LAZY_H
@@ -30,7 +30,8 @@
 
 namespace org { namespace bcom { namespace xpcf {
 
-template <class E> bool hasError(E e){};
+// only defined for the error code types : the XPCFErrorCode specialization follows
+template <class E> bool hasError(E e);
 
 template <> inline bool hasError(XPCFErrorCode e)
 {
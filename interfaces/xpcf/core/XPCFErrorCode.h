@@ -47,6 +47,7 @@ typedef enum {
     _ERROR_INTERFACE_UNKNOWN = -40,
     _ERROR_MODULE_UNKNOWN = -50,
     _ERROR_MODULE_MISSINGXPCF_ENTRY = -51,
+    _ERROR_MODULE_ABI_MISMATCH = -52,
     _ERROR_INJECTION_FAILED = -60,
     _ERROR_INJECTABLE_ALREADY_DECLARED = -61,
     _ERROR_INJECTABLE_UNKNOWN = -62 ,
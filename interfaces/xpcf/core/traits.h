@@ -4,7 +4,10 @@
 #include "xpcf/core/uuid.h"
 #include "xpcf/api/InterfaceTraits.h"
 #include "xpcf/component/ComponentTraits.h"
+#include <array>
+#include <cstdint>
 #include <map>
+#include <utility>
 
 namespace org {namespace bcom { namespace xpcf {
 
@@ -12,20 +15,100 @@ namespace org {namespace bcom { namespace xpcf {
 namespace uuids = boost::uuids;
 #endif
 
+namespace detail {
+
+constexpr int hexDigit(char c)
+{
+    return (c >= '0' && c <= '9') ? c - '0'
+         : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+         : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+         : -1;
+}
+
+constexpr std::size_t length(const char * str)
+{
+    std::size_t len = 0;
+    while (str[len] != '\0') {
+        len++;
+    }
+    return len;
+}
+
+// offset of the first hexadecimal digit : traits uuid strings are either "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" or "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}"
+constexpr std::size_t uuidOffset(const char * str)
+{
+    return (str[0] == '{') ? 1 : 0;
+}
+
+constexpr bool isUUIDString(const char * str)
+{
+    if (str == nullptr) {
+        return false;
+    }
+    std::size_t offset = uuidOffset(str);
+    if (length(str) != 36 + 2 * offset || (offset == 1 && str[36 + offset] != '}')) {
+        return false;
+    }
+    for (std::size_t i = 0; i < 36; i++) {
+        bool dash = (i == 8 || i == 13 || i == 18 || i == 23);
+        if (dash ? str[offset + i] != '-' : hexDigit(str[offset + i]) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr std::array<uint8_t, 16> parseUUID(const char * str)
+{
+    std::array<uint8_t, 16> bytes{};
+    std::size_t pos = uuidOffset(str);
+    for (std::size_t i = 0; i < 16; i++) {
+        if (str[pos] == '-') {
+            pos++;
+        }
+        bytes[i] = static_cast<uint8_t>(hexDigit(str[pos]) * 16 + hexDigit(str[pos + 1]));
+        pos += 2;
+    }
+    return bytes;
+}
+
+template <std::size_t... I>
+constexpr uuids::uuid makeUUID(const std::array<uint8_t, 16> & bytes, std::index_sequence<I...>)
+{
+#ifdef XPCF_USE_BOOST
+    return uuids::uuid{{bytes[I]...}};
+#else
+    return uuids::uuid(std::array<uuids::uuid::value_type, 16>{{bytes[I]...}});
+#endif
+}
+
+template <typename T>
+constexpr const char * traitsUUIDString()
+{
+    if constexpr (is_interface<T>::value) {
+        return InterfaceTraits<T>::UUID;
+    }
+    else {
+        return ComponentTraits<T>::UUID;
+    }
+}
+
+// uuid of the traits of T, parsed once at compile time
+template <typename T>
+constexpr uuids::uuid traitsUUID = makeUUID(parseUUID(traitsUUIDString<T>()), std::make_index_sequence<16>{});
+
+}
+
 template < typename T >
-inline uuids::uuid toUUID()
+constexpr uuids::uuid toUUID()
 {
     static_assert(is_interface<T>::value || is_component<T>::value,
                   "Type passed to toUUID is neither a component nor an interface "
                   "or [Interface/Component]Traits not defined for T !!");
-    std::string uuidString;
-    if (is_interface<T>::value) {
-        uuidString = InterfaceTraits<T>::UUID;
-    }
-    if (is_component<T>::value) {
-        uuidString = ComponentTraits<T>::UUID;
-    }
-    return toUUID(uuidString);
+    static_assert(detail::isUUIDString(detail::traitsUUIDString<T>()),
+                  "[Interface/Component]Traits UUID of T is not a valid uuid string : "
+                  "expected format is \"xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx\" with hexadecimal digits");
+    return detail::traitsUUID<T>;
 }
 
 template <typename T> std::map<std::string,std::string> toMap() {
@@ -27,7 +27,12 @@
 #include "xpcf/component/ComponentFactory.h"
 #include "xpcf/module/IModuleIndex.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace org { namespace bcom { namespace xpcf {
 
@@ -37,10 +42,65 @@ namespace org { namespace bcom { namespace xpcf {
 #define XPCF_GETMODULEDESCRIPTION "XPCF_getModuleDescription"
 #define XPCF_GETMODULEINDEX "XPCF_getModuleIndex"
 #define XPCF_GETXPCFVERSION "XPCF_getVersion"
+#define XPCF_GETCOMPONENTFACTORYTABLE "XPCF_getComponentFactoryTable"
+#define XPCF_GETABIVERSION "XPCF_getAbiVersion"
+
+// Version of the binary interface between xpcf and the modules : the IComponentIntrospect virtual table
+// and the component creation compiled in the modules by ComponentFactory::create.
+// It is bumped upon each break of this interface, and xpcf rejects the modules built upon another version.
+// Version 2 (xpcf 2.7.0) : IComponentIntrospect::interfaceAddress, and components references created through introspect
+#define XPCF_ABI_VERSION 2
 
 // getComponent signature is :
 // XPCFErrorCode XPCF_getComponent(const uuids::uuid &, SRef<IComponentIntrospect>&)
 
+// getAbiVersion signature is :
+// uint32_t XPCF_getAbiVersion()
+// modules built before its introduction don't export it : they are rejected as built upon another ABI version
+
+// getComponentFactoryTable signature is :
+// const ComponentFactoryTable * XPCF_getComponentFactoryTable()
+// the entry point is optional : modules built before its introduction only export XPCF_getComponent
+
+// creation function of one component of a module
+struct ComponentFactoryEntry {
+    // component uuid bytes, in the uuid string order
+    std::array<uint8_t, 16> uuid;
+    SRef<IComponentIntrospect> (*create)(void);
+};
+
+// components creation functions of a module, sorted by uuid bytes
+struct ComponentFactoryTable {
+    const ComponentFactoryEntry * entries;
+    std::size_t size;
+};
+
+/**
+ * @class ComponentFactoryTableBuilder
+ * @brief Builds the components creation table of a module from the XPCF_ADD_COMPONENT declarations.
+ */
+class ComponentFactoryTableBuilder {
+public:
+    template <typename T> void declareComponent()
+    {
+        static_assert(is_component<T>::value,
+                      "Type passed to declareComponent is not a component "
+                      "or componentTraits not defined !!");
+        m_entries.push_back(ComponentFactoryEntry{detail::parseUUID(ComponentTraits<T>::UUID), &ComponentFactory::create<T>});
+    }
+
+    ComponentFactoryTable table()
+    {
+        std::sort(m_entries.begin(), m_entries.end(), [](const ComponentFactoryEntry & left, const ComponentFactoryEntry & right) {
+            return left.uuid < right.uuid;
+        });
+        return ComponentFactoryTable{m_entries.data(), m_entries.size()};
+    }
+
+private:
+    std::vector<ComponentFactoryEntry> m_entries;
+};
+
 #define EXPORT_XPCF_getModuleUUID_FUNCTION \
 extern "C" XPCF_MODULEHOOKS_API const char * XPCF_getModuleUUID() \
 { \
@@ -65,14 +125,30 @@ extern "C" XPCF_MODULEHOOKS_API const char * XPCF_getVersion() \
     return xpcfVersion.c_str(); \
 }
 
+#define EXPORT_XPCF_getAbiVersion_FUNCTION \
+extern "C" XPCF_MODULEHOOKS_API uint32_t XPCF_getAbiVersion() \
+{ \
+    return XPCF_ABI_VERSION; \
+}
+
+// the components declarations feed both the module index and the components creation table
 #define XPCF_BEGIN_COMPONENTS_DECLARATION \
-extern "C" XPCF_MODULEHOOKS_API \
-void XPCF_getModuleIndex(SRef<org::bcom::xpcf::IModuleIndex> moduleIndexRef) {
+template <class ComponentsIndex> static void XPCF_declareComponents(ComponentsIndex & componentsIndex) {
 
 #define XPCF_ADD_COMPONENT(fullComponentType) \
-moduleIndexRef->declareComponent<fullComponentType>();
+componentsIndex.template declareComponent<fullComponentType>();
 
-#define XPCF_END_COMPONENTS_DECLARATION }
+#define XPCF_END_COMPONENTS_DECLARATION } \
+extern "C" XPCF_MODULEHOOKS_API \
+void XPCF_getModuleIndex(SRef<org::bcom::xpcf::IModuleIndex> moduleIndexRef) { \
+    XPCF_declareComponents(*moduleIndexRef); \
+} \
+extern "C" XPCF_MODULEHOOKS_API \
+const org::bcom::xpcf::ComponentFactoryTable * XPCF_getComponentFactoryTable() { \
+    static org::bcom::xpcf::ComponentFactoryTableBuilder builder; \
+    static const org::bcom::xpcf::ComponentFactoryTable table = (XPCF_declareComponents(builder), builder.table()); \
+    return &table; \
+}
 
 #define XPCF_DECLARE_MODULE(UUID, name, description) static std::string moduleUUID = UUID; \
     static std::string moduleName = name; \
@@ -81,7 +157,8 @@ moduleIndexRef->declareComponent<fullComponentType>();
     EXPORT_XPCF_getModuleUUID_FUNCTION \
     EXPORT_XPCF_getModuleName_FUNCTION \
     EXPORT_XPCF_getModuleDescription_FUNCTION \
-    EXPORT_XPCF_getVersion_FUNCTION
+    EXPORT_XPCF_getVersion_FUNCTION \
+    EXPORT_XPCF_getAbiVersion_FUNCTION
 
 
 template <class C> XPCFErrorCode tryCreateComponent(const uuids::uuid& expectedComponentUUID,
@@ -42,7 +42,8 @@ XPCF_DECLARE_MODULE("3b899ff0-e098-4218-bdaa-82abdec22960","xpcfSampleComponent"
 
 /**
  * This method is the module entry point.
- * XPCF uses this method to create components available in the module.
+ * XPCF uses this method to create the components missing from the components table that
+ * XPCF_END_COMPONENTS_DECLARATION exports, and to create components with xpcf versions preceding the table.
  *
  * Each component exposed must be declared inside a xpcf::tryCreateComponent<ComponentType>() call.
  */
@@ -22,6 +22,7 @@
 
 
 #include "private/xpcf/AliasManager.h"
+#include "private/xpcf/Logger.h"
 #include <xpcf/api/IModuleManager.h>
 #include <xpcf/core/ErrorMessage.h>
 #include <xpcf/core/Exception.h>
@@ -30,13 +31,11 @@
 using namespace std;
 using std::placeholders::_1;
 
-#ifdef XPCF_WITH_LOGS
-namespace logging = boost::log;
-#endif
-
 XPCF_DEFINE_FACTORY_CREATE_INSTANCE(org::bcom::xpcf::AliasManager);
 
 namespace org { namespace bcom { namespace xpcf {
+
+XPCF_DEFINE_LOGGER("AliasManager")
 constexpr const char * XMLALIASNODE = "alias";
 
 static const std::map<std::string,AliasManager::Type> aliasTypeConvertMap = {
@@ -85,10 +84,7 @@ AliasManager::AliasManager():ComponentBase(toUUID<AliasManager>())
     m_addAliasFunction[AliasManager::Type::Module] = [&](const std::string & name, const uuids::uuid & uuid, bool forceReplace) {
         ::org::bcom::xpcf::addAlias(m_context->moduleResolverMap, name, uuid, forceReplace);
     };
-#ifdef XPCF_WITH_LOGS
-    m_logger.add_attribute("ClassName", boost::log::attributes::constant<std::string>("AliasManager"));
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Constructor AliasManager::AliasManager () called!";
-#endif
+    XPCF_LOG(info) << "Constructor AliasManager::AliasManager () called!";
 }
 
 void AliasManager::clear()
@@ -182,18 +178,12 @@ void AliasManager::declareAliases(tinyxml2::XMLElement * xmlAliasManagerElt)
 
 const uuids::uuid & AliasManager::resolveAlias(const std::string & name, const std::map<std::string, uuids::uuid> & elementMap)
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"AliasManager::resolveAlias name="<<name;
-#endif
+    XPCF_LOG(info) << "AliasManager::resolveAlias name="<<name;
     if (elementMap.find(name) == elementMap.end()) {
-#ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"AliasManager::resolveAlias no alias found for "<<name;
-#endif
+        XPCF_LOG(info) << "AliasManager::resolveAlias no alias found for "<<name;
         throw Exception("Unknown alias : no alias found for name " + name);
     }
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"AliasManager::resolveAlias name='"<<name<<"' resolved to uuid='"<<uuids::to_string(elementMap.at(name))<<"'";
-#endif
+    XPCF_LOG(info) << "AliasManager::resolveAlias name='"<<name<<"' resolved to uuid='"<<uuids::to_string(elementMap.at(name))<<"'";
     return elementMap.at(name);
 }
 
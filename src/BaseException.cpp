@@ -27,6 +27,7 @@ std::map<XPCFErrorCode, std::string> xpcfBaseErrorCodeToMessageMap = {
     { XPCFErrorCode::_ERROR_INTERFACE_UNKNOWN , "ERROR: unknown interface" },
     { XPCFErrorCode::_ERROR_MODULE_UNKNOWN , "ERROR: unknown module" },
     { XPCFErrorCode::_ERROR_MODULE_MISSINGXPCF_ENTRY , "ERROR: missing xpcf method(s) in the library (either one or several from getModuleUUID, getModuleName, getComponent ... )" },
+    { XPCFErrorCode::_ERROR_MODULE_ABI_MISMATCH , "ERROR: the module was built upon another xpcf binary interface version" },
     { XPCFErrorCode::_ERROR_INJECTION_FAILED , "ERROR: injection failed" },
     { XPCFErrorCode::_ERROR_INJECTABLE_UNKNOWN , "ERROR: injectable unknown" },
     { XPCFErrorCode::_ERROR_INJECTABLE_ALREADY_DECLARED , "ERROR: injectable already declared" },
@@ -22,74 +22,329 @@
 
 #include "xpcf/component/ComponentBase.h"
 #include "private/xpcf/PropertyManager.h"
+#include "private/xpcf/ModuleManager.h"
+#include "private/xpcf/Logger.h"
 #include "xpcf/core/Exception.h"
 #include "xpcf/core/helpers.h"
 #include "xpcf/api/IModuleManager.h"
 #include <iostream>
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
 #include <xpcf/collection/Collection.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
 #include <string>
 
 using namespace std;
 
-namespace logging = boost::log;
-
 namespace org { namespace bcom { namespace xpcf {
 
+XPCF_DEFINE_LOGGER("ComponentBase")
+
 template class IEnumerable<uuids::uuid>;
 
+/**
+ * @class InterfaceTable
+ * @brief Interfaces declared by a component type, shared between the instances of the type.
+ *
+ * Each instance points to the table matching the interfaces it declared so far. The table of a component type is built
+ * by its first instance, one declaration at a time : each table links to its extension with the next declared interface.
+ * Further instances follow the links while their declarations match, without any allocation.
+ * An instance whose declarations differ (interfaces declared upon a condition, or upon another object than the component)
+ * builds its own tables.
+ * Tables are immutable once built : lookups don't lock.
+ */
+class InterfaceTable {
+public:
+    struct Entry {
+        InterfaceMetadata metadata;
+        // interface address offset from the ComponentBase subobject
+        std::ptrdiff_t offset;
+        utils::any (*cast)(void *);
+    };
+
+    InterfaceTable() = default;
+    InterfaceTable(const InterfaceTable & table, Entry && entry);
+
+    // the empty table of componentUUID type
+    static SRef<const InterfaceTable> root(const uuids::uuid & componentUUID);
+    // the table extending table with the interface : the metadata are only built when no existing table matches
+    static SRef<const InterfaceTable> extend(const SRef<const InterfaceTable> & table, const uuids::uuid & interfaceUUID, std::ptrdiff_t offset,
+                                             utils::any (*cast)(void *), const char * name, const char * description);
+
+    const Entry * find(const uuids::uuid & interfaceUUID) const;
+    const std::vector<Entry> & entries() const { return m_entries; }
+    const IEnumerable<uuids::uuid> & getInterfaces() const { return m_interfacesUUID; }
+
+private:
+    std::vector<Entry> m_entries;
+    // uuids sorted for binary search, with their entry index
+    std::vector<std::pair<uuids::uuid, uint32_t>> m_index;
+    Collection<uuids::uuid,vector> m_interfacesUUID;
+    mutable SRef<const InterfaceTable> m_next;
+
+    static std::mutex m_mutex;
+    static SRef<const std::map<uuids::uuid, SRef<const InterfaceTable>>> m_roots;
+};
+
+std::mutex InterfaceTable::m_mutex;
+SRef<const std::map<uuids::uuid, SRef<const InterfaceTable>>> InterfaceTable::m_roots = utils::make_shared<std::map<uuids::uuid, SRef<const InterfaceTable>>>();
+
+InterfaceTable::InterfaceTable(const InterfaceTable & table, Entry && entry):m_entries(table.m_entries), m_index(table.m_index)
+{
+    m_entries.push_back(std::move(entry));
+    const uuids::uuid & interfaceUUID = m_entries.back().metadata.getUUID();
+    m_index.insert(std::upper_bound(m_index.begin(), m_index.end(), make_pair(interfaceUUID, uint32_t(0)),
+                                    [](auto & left, auto & right) { return left.first < right.first; }),
+                   make_pair(interfaceUUID, static_cast<uint32_t>(m_entries.size() - 1)));
+    for (auto & tableEntry : m_entries) {
+        m_interfacesUUID.add(tableEntry.metadata.getUUID());
+    }
+}
+
+SRef<const InterfaceTable> InterfaceTable::root(const uuids::uuid & componentUUID)
+{
+    SRef<const std::map<uuids::uuid, SRef<const InterfaceTable>>> roots = utils::atomic_load(&m_roots);
+    auto rootIt = roots->find(componentUUID);
+    if (rootIt != roots->end()) {
+        return rootIt->second;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    roots = utils::atomic_load(&m_roots);
+    rootIt = roots->find(componentUUID);
+    if (rootIt != roots->end()) {
+        return rootIt->second;
+    }
+    SRef<std::map<uuids::uuid, SRef<const InterfaceTable>>> newRoots = utils::make_shared<std::map<uuids::uuid, SRef<const InterfaceTable>>>(*roots);
+    SRef<const InterfaceTable> table = utils::make_shared<InterfaceTable>();
+    (*newRoots)[componentUUID] = table;
+    utils::atomic_store(&m_roots, SRef<const std::map<uuids::uuid, SRef<const InterfaceTable>>>(newRoots));
+    return table;
+}
+
+SRef<const InterfaceTable> InterfaceTable::extend(const SRef<const InterfaceTable> & table, const uuids::uuid & interfaceUUID, std::ptrdiff_t offset,
+                                                  utils::any (*cast)(void *), const char * name, const char * description)
+{
+    SRef<const InterfaceTable> next = utils::atomic_load(&table->m_next);
+    auto matches = [&](const SRef<const InterfaceTable> & candidate) {
+        const Entry & last = candidate->m_entries.back();
+        return last.offset == offset && last.cast == cast && last.metadata.getUUID() == interfaceUUID;
+    };
+    if (next && matches(next)) {
+        return next;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    next = utils::atomic_load(&table->m_next);
+    if (next && matches(next)) {
+        return next;
+    }
+    SRef<const InterfaceTable> extension = utils::make_shared<InterfaceTable>(*table, Entry{InterfaceMetadata(name, interfaceUUID, description), offset, cast});
+    if (!next) {
+        // the first extension is the one shared : other ones belong to the instances that built them
+        utils::atomic_store(&table->m_next, extension);
+    }
+    return extension;
+}
+
+const InterfaceTable::Entry * InterfaceTable::find(const uuids::uuid & interfaceUUID) const
+{
+    auto indexIt = std::lower_bound(m_index.begin(), m_index.end(), interfaceUUID,
+                                    [](const std::pair<uuids::uuid, uint32_t> & item, const uuids::uuid & key) { return item.first < key; });
+    if (indexIt == m_index.end() || indexIt->first != interfaceUUID) {
+        return nullptr;
+    }
+    return &m_entries[indexIt->second];
+}
+
+/**
+ * @class InjectableTable
+ * @brief Injectables declared by a component type, shared between the instances of the type.
+ *
+ * Tables are built and shared as interfaces tables : each table links to its extension with the next declared injectable,
+ * and an instance only follows the links while its declarations match.
+ * A component declares a few injectables : lookups scan the entries.
+ */
+class InjectableTable {
+public:
+    struct Declaration {
+        uuids::uuid interfaceUUID;
+        // nullptr for an unnamed injectable
+        const char * name;
+        bool optional;
+        // injectable address offset from the IInjectable subobject
+        std::ptrdiff_t offset;
+        Injector::Setter setter;
+        Injector::MultiSetter multiSetter;
+        Injector::LazySetter lazySetter;
+        utils::any (*retrieve)(void *);
+    };
+
+    struct Entry {
+        SPtr<Injector> injector;
+        Injector::Setter setter;
+        Injector::MultiSetter multiSetter;
+        Injector::LazySetter lazySetter;
+        utils::any (*retrieve)(void *);
+    };
+
+    InjectableTable() = default;
+    InjectableTable(const InjectableTable & table, Entry && entry);
+
+    // the empty table of componentUUID type
+    static SRef<const InjectableTable> root(const uuids::uuid & componentUUID);
+    // the table extending table with the injectable : the injector is only built when no existing table matches
+    // throws InjectableDeclarationException when the injectable is already declared
+    static SRef<const InjectableTable> extend(const SRef<const InjectableTable> & table, const Declaration & declaration);
+
+    // name is nullptr for an unnamed injectable
+    const Entry * find(const uuids::uuid & interfaceUUID, const char * name, bool multi) const;
+    const IEnumerable<SPtr<Injector>> & getInjectables() const { return m_injectors; }
+
+private:
+    static bool matches(const Entry & entry, const Declaration & declaration);
+
+    std::vector<Entry> m_entries;
+    Collection<SPtr<Injector>,vector> m_injectors;
+    mutable SRef<const InjectableTable> m_next;
+
+    static std::mutex m_mutex;
+    static SRef<const std::map<uuids::uuid, SRef<const InjectableTable>>> m_roots;
+};
+
+std::mutex InjectableTable::m_mutex;
+SRef<const std::map<uuids::uuid, SRef<const InjectableTable>>> InjectableTable::m_roots = utils::make_shared<std::map<uuids::uuid, SRef<const InjectableTable>>>();
+
+InjectableTable::InjectableTable(const InjectableTable & table, Entry && entry):m_entries(table.m_entries)
+{
+    m_entries.push_back(std::move(entry));
+    for (auto & tableEntry : m_entries) {
+        m_injectors.add(tableEntry.injector);
+    }
+}
+
+SRef<const InjectableTable> InjectableTable::root(const uuids::uuid & componentUUID)
+{
+    SRef<const std::map<uuids::uuid, SRef<const InjectableTable>>> roots = utils::atomic_load(&m_roots);
+    auto rootIt = roots->find(componentUUID);
+    if (rootIt != roots->end()) {
+        return rootIt->second;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    roots = utils::atomic_load(&m_roots);
+    rootIt = roots->find(componentUUID);
+    if (rootIt != roots->end()) {
+        return rootIt->second;
+    }
+    SRef<std::map<uuids::uuid, SRef<const InjectableTable>>> newRoots = utils::make_shared<std::map<uuids::uuid, SRef<const InjectableTable>>>(*roots);
+    SRef<const InjectableTable> table = utils::make_shared<InjectableTable>();
+    (*newRoots)[componentUUID] = table;
+    utils::atomic_store(&m_roots, SRef<const std::map<uuids::uuid, SRef<const InjectableTable>>>(newRoots));
+    return table;
+}
+
+bool InjectableTable::matches(const Entry & entry, const Declaration & declaration)
+{
+    if (entry.setter != declaration.setter || entry.multiSetter != declaration.multiSetter || entry.lazySetter != declaration.lazySetter
+            || entry.retrieve != declaration.retrieve || entry.injector->offset() != declaration.offset
+            || entry.injector->optional() != declaration.optional || entry.injector->getUuid() != declaration.interfaceUUID) {
+        return false;
+    }
+    if (declaration.name == nullptr) {
+        return !entry.injector->isNamed();
+    }
+    return entry.injector->isNamed() && std::strcmp(entry.injector->getName(), declaration.name) == 0;
+}
+
+SRef<const InjectableTable> InjectableTable::extend(const SRef<const InjectableTable> & table, const Declaration & declaration)
+{
+    SRef<const InjectableTable> next = utils::atomic_load(&table->m_next);
+    if (next && matches(next->m_entries.back(), declaration)) {
+        return next;
+    }
+    if (table->find(declaration.interfaceUUID, declaration.name, declaration.multiSetter != nullptr) != nullptr) {
+        SPtr<InjectableMetadata> injMdata = (declaration.name == nullptr) ? utils::make_shared<InjectableMetadata>(declaration.interfaceUUID, declaration.optional)
+                                                                           : utils::make_shared<InjectableMetadata>(declaration.interfaceUUID, declaration.name, declaration.optional);
+        throw InjectableDeclarationException(injMdata);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    next = utils::atomic_load(&table->m_next);
+    if (next && matches(next->m_entries.back(), declaration)) {
+        return next;
+    }
+    SPtr<Injector> injector;
+    if (declaration.multiSetter != nullptr) {
+        injector = utils::make_shared<Injector>(declaration.multiSetter, declaration.offset, declaration.interfaceUUID, declaration.optional);
+    }
+    else if (declaration.lazySetter != nullptr) {
+        injector = (declaration.name == nullptr) ? utils::make_shared<Injector>(declaration.lazySetter, declaration.offset, declaration.interfaceUUID, declaration.optional)
+                                                 : utils::make_shared<Injector>(declaration.lazySetter, declaration.offset, declaration.interfaceUUID, declaration.name, declaration.optional);
+    }
+    else {
+        injector = (declaration.name == nullptr) ? utils::make_shared<Injector>(declaration.setter, declaration.offset, declaration.interfaceUUID, declaration.optional)
+                                                 : utils::make_shared<Injector>(declaration.setter, declaration.offset, declaration.interfaceUUID, declaration.name, declaration.optional);
+    }
+    SRef<const InjectableTable> extension = utils::make_shared<InjectableTable>(*table, Entry{injector, declaration.setter, declaration.multiSetter,
+                                                                                              declaration.lazySetter, declaration.retrieve});
+    if (!next) {
+        // the first extension is the one shared : other ones belong to the instances that built them
+        utils::atomic_store(&table->m_next, extension);
+    }
+    return extension;
+}
+
+const InjectableTable::Entry * InjectableTable::find(const uuids::uuid & interfaceUUID, const char * name, bool multi) const
+{
+    // lazy and plain injectables share their keys : an interface can't be declared both as a lazy and as a plain injectable
+    for (auto & entry : m_entries) {
+        if (entry.injector->getUuid() != interfaceUUID || (entry.multiSetter != nullptr) != multi || entry.injector->isNamed() != (name != nullptr)) {
+            continue;
+        }
+        if (name == nullptr || std::strcmp(entry.injector->getName(), name) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
 class ComponentBase::InternalImpl {
 
 public:
-    InternalImpl(const uuids::uuid& componentUUID):m_componentUUID(componentUUID) {}
+    InternalImpl(const uuids::uuid& componentUUID):m_injectables(InjectableTable::root(componentUUID)),
+        m_componentUUID(componentUUID), m_interfaces(InterfaceTable::root(componentUUID)) {}
     ~InternalImpl() = default;
-    void declareInterface(const uuids::uuid & interfaceUUID, utils::any aThis, const char * name, const char * description);
+    void declareInterface(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, utils::any (*cast)(void *), const char * name, const char * description);
     const InterfaceMetadata & getMetadata(const uuids::uuid& interfaceUUID) const;
-    utils::any queryInterface(const uuids::uuid& interfaceUUID) const;
+    const InterfaceTable::Entry & findInterface(const uuids::uuid& interfaceUUID) const;
     bool implements(const uuids::uuid& interfaceUUID) const;
 
     uint32_t getNbInterfaces() const;
-    const IEnumerable<uuids::uuid> & getInterfaces() const { return m_interfacesUUID; }
-
-    inline boost::log::sources::severity_logger< boost::log::trivial::severity_level > & getLogger() { return m_logger; }
-    // IEnumerable
-    /*   inline UniqueRef<IEnumerator<uuids::uuid>> getEnumerator() {
-        return unixpcf::make_unique<Enumerator<uuids::uuid, vector>>(m_interfacesUUID);
-    }
-
-    inline uint32_t size() { return m_interfacesUUID.size(); }*/
-
-    Collection<SPtr<Injector>,vector> m_injectablesCollection;
-    //std::map<uuids::uuid,std::reference_wrapper<utils::any>> m_injectablesMap;
-    std::map<uuids::uuid, utils::any> m_injectablesMap;
-    std::map<uuids::uuid, utils::any> m_multiInjectablesMap;
-    std::map<std::pair<uuids::uuid, std::string>, utils::any> m_namedInjectablesMap;
+    const IEnumerable<uuids::uuid> & getInterfaces() const { return m_interfaces->getInterfaces(); }
+
+    // injectables table shared with the other instances of the component type
+    SRef<const InjectableTable> m_injectables;
+    // set for pooled components : returns the released instance to its pool
+    std::function<bool(ComponentBase *)> m_recycler;
+    // set for the components created from a module
+    SRef<ModuleHandle> m_module;
+    // reference aliased by the interfaces references while at least one of them is alive :
+    // read with atomic_load, the mutex only serializes the creation of a new reference
+    std::mutex m_selfMutex;
+    SRef<const utils::weak_ptr<IComponentIntrospect>> m_self;
+    // the first reference is published from this member without allocation : it is never written afterwards
+    utils::weak_ptr<IComponentIntrospect> m_firstSelf;
 
 private:
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
     InternalImpl(InternalImpl const &);
     InternalImpl & operator=(InternalImpl const &);
 
-    struct XPCF_ObjectInterface {
-        XPCF_ObjectInterface(InterfaceMetadata metadata):m_metadata(metadata){}
-        InterfaceMetadata m_metadata;
-        utils::any m_component;
-    };
-
-    Collection<uuids::uuid,vector> m_interfacesUUID;
-    std::map<uuids::uuid, UniqueRef<XPCF_ObjectInterface>> m_interfaces;
-    const uuids::uuid & m_componentUUID;
+    const uuids::uuid m_componentUUID;
+    // interfaces table shared with the other instances of the component type
+    SRef<const InterfaceTable> m_interfaces;
 };
 
 ComponentBase::ComponentBase(const uuids::uuid & uuid)
     :m_UUID(uuid), m_pimpl(new InternalImpl(uuid)), m_usageRefCount(0)
 {
-#ifdef XPCF_WITH_LOGS
-    m_pimpl->getLogger().add_attribute("ClassName", boost::log::attributes::constant<std::string>("ComponentBase"));
-    BOOST_LOG_SEV(m_pimpl->getLogger(), logging::trivial::info)<<uuids::to_string(m_UUID)<<" ComponentBase::ComponentBase construction";
-#endif
+    XPCF_LOG(info) << uuids::to_string(m_UUID)<<" ComponentBase::ComponentBase construction";
     declareInterface<IComponentIntrospect>(this);
     declareInterface<IInjectable>(this);
 }
@@ -102,38 +357,77 @@ ComponentBase::ComponentBase(std::map<std::string,std::string> componentTrait)
 
 ComponentBase::~ComponentBase()
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_pimpl->getLogger(), logging::trivial::info)<<uuids::to_string(m_UUID)<<" ComponentBase::~ComponentBase destruction";
-#endif
+    XPCF_LOG(info) << uuids::to_string(m_UUID)<<" ComponentBase::~ComponentBase destruction";
 }
 
 void ComponentBase::onInjected()
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_pimpl->getLogger(), logging::trivial::info)<<" ComponentBase::onInjected";
-#endif
+    XPCF_LOG(info) << " ComponentBase::onInjected";
+}
+
+void ComponentBase::onRecycled()
+{
+    XPCF_LOG(info) << " ComponentBase::onRecycled";
+}
+
+void ComponentBase::setRecycler(const std::function<bool(ComponentBase *)> & recycler)
+{
+    m_pimpl->m_recycler = recycler;
+}
+
+bool ComponentBase::setModule(const SRef<ModuleHandle> & module)
+{
+    if (m_pimpl->m_module) {
+        return false;
+    }
+    m_pimpl->m_module = module;
+    return true;
+}
+
+bool ComponentBase::recycle()
+{
+    if (!m_pimpl->m_recycler) {
+        return false;
+    }
+    try {
+        onRecycled();
+    }
+    catch (const std::exception &) {
+        // the instance can't be reset : don't reuse it
+        return false;
+    }
+    return m_pimpl->m_recycler(this);
 }
 
 void ComponentBase::addComponentRef()
 {
-    // NOTE : add/releaseComponentRef not synchronized !
-    m_usageRefCount++;
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_pimpl->getLogger(), logging::trivial::info)<<uuids::to_string(m_UUID)<<" ComponentBase::addComponentRef refcount="<<m_usageRefCount;
-#endif
+    // a new reference is always created from an existing one (or upon creation) : the increment needs no ordering
+    m_usageRefCount.fetch_add(1, std::memory_order_relaxed);
+    XPCF_LOG(info) << uuids::to_string(m_UUID)<<" ComponentBase::addComponentRef refcount="<<m_usageRefCount;
 }
 
 void ComponentBase::releaseComponentRef()
 {
-    m_usageRefCount--;
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_pimpl->getLogger(), logging::trivial::info)<<uuids::to_string(m_UUID)<<" ComponentBase::releaseComponentRef refcount="<<m_usageRefCount;
-#endif
-    if (m_usageRefCount == 0) {
-#ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_pimpl->getLogger(), logging::trivial::info)<<uuids::to_string(m_UUID)<<" ComponentBase::releaseComponentRef calling unloadComponent";
-#endif
-        this->unloadComponent();
+    // the last reference owner is the only one to see the count reach zero, even when references are released concurrently
+    uint32_t usageRefCount = m_usageRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    XPCF_LOG(info) << uuids::to_string(m_UUID)<<" ComponentBase::releaseComponentRef refcount="<<usageRefCount;
+    if (usageRefCount == 0) {
+        if (recycle()) {
+            // the pool owns the instance until its next resolution
+            return;
+        }
+        XPCF_LOG(info) << uuids::to_string(m_UUID)<<" ComponentBase::releaseComponentRef calling unloadComponent";
+        unload();
+    }
+}
+
+void ComponentBase::unload()
+{
+    // the module code runs until unloadComponent returns : the module is released afterwards
+    SRef<ModuleHandle> module = std::move(m_pimpl->m_module);
+    this->unloadComponent();
+    if (module) {
+        ModuleManager::instance()->releaseModuleRef(module);
     }
 }
 
@@ -154,7 +448,45 @@ const InterfaceMetadata & ComponentBase::getMetadata(const uuids::uuid& interfac
 
 SRef<IComponentIntrospect> ComponentBase::introspect()
 {
-    return IComponentIntrospect::acquireComponentRef<remove_pointer<decltype(this)>::type, IComponentIntrospect>(this);
+    // the component reference counter is incremented once per control block :
+    // a new block is only created when every previous reference has been released
+    SRef<const utils::weak_ptr<IComponentIntrospect>> selfRef = utils::atomic_load(&m_pimpl->m_self);
+    SRef<IComponentIntrospect> self;
+    if (selfRef) {
+        self = selfRef->lock();
+        if (self) {
+            return self;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_pimpl->m_selfMutex);
+    // another thread may have created the reference meanwhile
+    selfRef = utils::atomic_load(&m_pimpl->m_self);
+    if (selfRef) {
+        self = selfRef->lock();
+        if (self) {
+            return self;
+        }
+    }
+    self = IComponentIntrospect::acquireComponentRef<remove_pointer<decltype(this)>::type, IComponentIntrospect>(this);
+    if (!selfRef) {
+        // the published reference doesn't own the member : the component outlives its readers
+        m_pimpl->m_firstSelf = self;
+        selfRef = SRef<const utils::weak_ptr<IComponentIntrospect>>(SRef<void>(), &m_pimpl->m_firstSelf);
+    }
+    else {
+        selfRef = utils::make_shared<utils::weak_ptr<IComponentIntrospect>>(self);
+    }
+    utils::atomic_store(&m_pimpl->m_self, selfRef);
+    return self;
+}
+
+utils::weak_ptr<IComponentIntrospect> ComponentBase::selfReference()
+{
+    SRef<const utils::weak_ptr<IComponentIntrospect>> selfRef = utils::atomic_load(&m_pimpl->m_self);
+    if (!selfRef) {
+        return utils::weak_ptr<IComponentIntrospect>();
+    }
+    return *selfRef;
 }
 
 const char * ComponentBase::getDescription(const uuids::uuid& interfaceUUID) const
@@ -162,93 +494,102 @@ const char * ComponentBase::getDescription(const uuids::uuid& interfaceUUID) con
     return m_pimpl->getMetadata(interfaceUUID).description();
 }
 
-void ComponentBase::declareInterface(const uuids::uuid & interfaceUUID, utils::any componentThis, const char * name, const char * description)
+void ComponentBase::declareInterface(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, utils::any (*cast)(void *),
+                                     const char * name, const char * description)
 {
-    m_pimpl->declareInterface(interfaceUUID, componentThis, name, description);
+    m_pimpl->declareInterface(interfaceUUID, offset, cast, name, description);
 }
 
 utils::any ComponentBase::queryInterface(const uuids::uuid& interfaceUUID) const
 {
-    return m_pimpl->queryInterface(interfaceUUID);
+    const InterfaceTable::Entry & entry = m_pimpl->findInterface(interfaceUUID);
+    const char * address = reinterpret_cast<const char *>(this) + entry.offset;
+    return entry.cast(const_cast<char *>(address));
 }
 
-void ComponentBase::declareInjectable(const uuids::uuid & interfaceUUID, utils::any injectable, const std::function<void(SRef<IComponentIntrospect>)> & injector, const char * instanceName, bool optional)
+void * ComponentBase::interfaceAddress(const uuids::uuid& interfaceUUID) const
 {
-    pair<uuids::uuid,string> key = make_pair(interfaceUUID,instanceName);
-    SPtr<Injector> injMdata = utils::make_shared<Injector>(injector,interfaceUUID,instanceName,optional);
-    if (mapContains(m_pimpl->m_namedInjectablesMap, key)) {
-         throw InjectableDeclarationException(injMdata);
-    }
-    m_pimpl->m_namedInjectablesMap[key] = injectable;
-    m_pimpl->m_injectablesCollection.add(injMdata);
+    const InterfaceTable::Entry & entry = m_pimpl->findInterface(interfaceUUID);
+    const char * address = reinterpret_cast<const char *>(this) + entry.offset;
+    return const_cast<char *>(address);
 }
 
-void ComponentBase::declareInjectable(const uuids::uuid &  interfaceUUID, utils::any injectable, const std::function<void(SRef<IComponentIntrospect>)> & injector, bool optional)
+void ComponentBase::declareInjectable(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, Injector::Setter setter, utils::any (*retrieve)(void *),
+                                      const char * instanceName, bool optional)
 {
-    SPtr<Injector> injMdata = utils::make_shared<Injector>(injector,interfaceUUID,optional);
-    if (mapContains(m_pimpl->m_injectablesMap, interfaceUUID)) {
-         throw InjectableDeclarationException(injMdata);
-    }
-    m_pimpl->m_injectablesMap[interfaceUUID] = injectable;
-    m_pimpl->m_injectablesCollection.add(injMdata);
+    m_pimpl->m_injectables = InjectableTable::extend(m_pimpl->m_injectables, {interfaceUUID, instanceName, optional, offset, setter, nullptr, nullptr, retrieve});
 }
 
-void ComponentBase::declareMultiInjectable(const uuids::uuid& interfaceUUID, utils::any injectable, const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector, bool optional)
+void ComponentBase::declareInjectable(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, Injector::Setter setter, utils::any (*retrieve)(void *),
+                                      bool optional)
 {
-    SPtr<Injector> injMdata = utils::make_shared<Injector>(injector,interfaceUUID,optional);
-    if (mapContains(m_pimpl->m_multiInjectablesMap, interfaceUUID)) {
-         throw InjectableDeclarationException(injMdata);
-    }
-    m_pimpl->m_multiInjectablesMap[interfaceUUID] = injectable;
-    m_pimpl->m_injectablesCollection.add(injMdata);
+    m_pimpl->m_injectables = InjectableTable::extend(m_pimpl->m_injectables, {interfaceUUID, nullptr, optional, offset, setter, nullptr, nullptr, retrieve});
+}
+
+void ComponentBase::declareMultiInjectable(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, Injector::MultiSetter setter, utils::any (*retrieve)(void *),
+                                           bool optional)
+{
+    m_pimpl->m_injectables = InjectableTable::extend(m_pimpl->m_injectables, {interfaceUUID, nullptr, optional, offset, nullptr, setter, nullptr, retrieve});
+}
+
+void ComponentBase::declareLazyInjectable(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, Injector::LazySetter setter, utils::any (*retrieve)(void *),
+                                          const char * instanceName, bool optional)
+{
+    m_pimpl->m_injectables = InjectableTable::extend(m_pimpl->m_injectables, {interfaceUUID, instanceName, optional, offset, nullptr, nullptr, setter, retrieve});
 }
 
+void ComponentBase::declareLazyInjectable(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, Injector::LazySetter setter, utils::any (*retrieve)(void *),
+                                          bool optional)
+{
+    m_pimpl->m_injectables = InjectableTable::extend(m_pimpl->m_injectables, {interfaceUUID, nullptr, optional, offset, nullptr, nullptr, setter, retrieve});
+}
 
 utils::any ComponentBase::retrieveInjectable(const uuids::uuid & interfaceUUID) const
 {
-    if (!mapContains(m_pimpl->m_injectablesMap, interfaceUUID)) {
+    const InjectableTable::Entry * entry = m_pimpl->m_injectables->find(interfaceUUID, nullptr, false);
+    if (entry == nullptr) {
         SPtr<InjectableMetadata> injMdata = utils::make_shared<InjectableMetadata>(interfaceUUID);
          throw InjectionException(injMdata, XPCFErrorCode::_ERROR_INJECTABLE_UNKNOWN);
     }
-    return m_pimpl->m_injectablesMap.at(interfaceUUID);
+    return entry->retrieve(entry->injector->injectable(*const_cast<ComponentBase *>(this)));
 }
 
 utils::any ComponentBase::retrieveInjectable(const uuids::uuid & interfaceUUID, const char * name) const
 {
-    pair<uuids::uuid,string> key = make_pair(interfaceUUID,name);
-    if (!mapContains(m_pimpl->m_namedInjectablesMap, key)) {
+    const InjectableTable::Entry * entry = m_pimpl->m_injectables->find(interfaceUUID, name, false);
+    if (entry == nullptr) {
         SPtr<InjectableMetadata> injMdata = utils::make_shared<InjectableMetadata>(interfaceUUID,name);
         throw InjectionException(injMdata, XPCFErrorCode::_ERROR_INJECTABLE_UNKNOWN);
     }
-    return m_pimpl->m_namedInjectablesMap.at(key);
+    return entry->retrieve(entry->injector->injectable(*const_cast<ComponentBase *>(this)));
 }
 
 
 
 utils::any ComponentBase::retrieveMultiInjectable(const uuids::uuid & interfaceUUID)
 {
-    if (!mapContains(m_pimpl->m_multiInjectablesMap, interfaceUUID)) {
+    const InjectableTable::Entry * entry = m_pimpl->m_injectables->find(interfaceUUID, nullptr, true);
+    if (entry == nullptr) {
         SPtr<InjectableMetadata> injMdata = utils::make_shared<InjectableMetadata>(interfaceUUID);
         throw InjectionException(injMdata, XPCFErrorCode::_ERROR_INJECTABLE_UNKNOWN);
     }
-    return m_pimpl->m_multiInjectablesMap.at(interfaceUUID);
+    return entry->retrieve(entry->injector->injectable(*this));
 }
 
 bool ComponentBase::injectExists(const uuids::uuid & interfaceUUID) const
 {
-    return mapContains(m_pimpl->m_injectablesMap, interfaceUUID);
+    return m_pimpl->m_injectables->find(interfaceUUID, nullptr, false) != nullptr;
 }
 
 bool ComponentBase::injectExists(const uuids::uuid & interfaceUUID, const char * name) const
 {
-    pair<uuids::uuid,string> key = make_pair(interfaceUUID,name);
-    return mapContains(m_pimpl->m_namedInjectablesMap, key);
+    return m_pimpl->m_injectables->find(interfaceUUID, name, false) != nullptr;
 }
 
 
 const IEnumerable<SPtr<Injector>> & ComponentBase::getInjectables() const
 {
-    return m_pimpl->m_injectablesCollection;
+    return m_pimpl->m_injectables->getInjectables();
 }
 
 bool ComponentBase::implements(const uuids::uuid& interfaceUUID) const
@@ -258,42 +599,38 @@ bool ComponentBase::implements(const uuids::uuid& interfaceUUID) const
 
 uint32_t ComponentBase::InternalImpl::getNbInterfaces() const
 {
-    return m_interfaces.size();
+    return m_interfaces->entries().size();
 }
 
-void ComponentBase::InternalImpl::declareInterface(const uuids::uuid & interfaceUUID, utils::any componentThis, const char * name, const char * description)
+void ComponentBase::InternalImpl::declareInterface(const uuids::uuid & interfaceUUID, std::ptrdiff_t offset, utils::any (*cast)(void *),
+                                                   const char * name, const char * description)
 {
-    if (! mapContains(m_interfaces,interfaceUUID)) {
-        InterfaceMetadata data(name,interfaceUUID, description);
-        m_interfaces[interfaceUUID] = unixpcf::make_unique<struct XPCF_ObjectInterface>(data);
-        m_interfaces[interfaceUUID]->m_component = componentThis;
-        m_interfacesUUID.add(interfaceUUID);
+    if (m_interfaces->find(interfaceUUID) == nullptr) {
+        m_interfaces = InterfaceTable::extend(m_interfaces, interfaceUUID, offset, cast, name, description);
     }
 }
 
-utils::any ComponentBase::InternalImpl::queryInterface(const uuids::uuid& interfaceUUID) const
+const InterfaceTable::Entry & ComponentBase::InternalImpl::findInterface(const uuids::uuid& interfaceUUID) const
 {
-    utils::any component;
-    if (mapContains(m_interfaces,interfaceUUID)) {
-        component = m_interfaces.at(interfaceUUID)->m_component;
-    }
-    else {
+    const InterfaceTable::Entry * entry = m_interfaces->find(interfaceUUID);
+    if (entry == nullptr) {
         throw InterfaceNotImplementedException(m_componentUUID,interfaceUUID);
     }
-    return component;
+    return *entry;
 }
 
 bool ComponentBase::InternalImpl::implements(const uuids::uuid& interfaceUUID) const
 {
-    return mapContains(m_interfaces,interfaceUUID);
+    return m_interfaces->find(interfaceUUID) != nullptr;
 }
 
 const InterfaceMetadata & ComponentBase::InternalImpl::getMetadata(const uuids::uuid& interfaceUUID) const
 {
-    if (! mapContains(m_interfaces,interfaceUUID)) {
+    const InterfaceTable::Entry * entry = m_interfaces->find(interfaceUUID);
+    if (entry == nullptr) {
         throw InterfaceNotImplementedException("Interface not found");
     }
-    return m_interfaces.at(interfaceUUID)->m_metadata;
+    return entry->metadata;
 }
 
 
@@ -23,6 +23,7 @@
 #include <xpcf/api/IConfigurable.h>
 #include "private/xpcf/ModuleManager.h"
 #include "private/xpcf/ComponentManager.h"
+#include "private/xpcf/Logger.h"
 #include <xpcf/component/ComponentFactory.h>
 #include <xpcf/core/Exception.h>
 #include "private/xpcf/PathBuilder.h"
@@ -34,17 +35,13 @@
 using namespace std;
 using std::placeholders::_1;
 using std::placeholders::_2;
-//namespace logging = boost::log;
-
-#include <boost/filesystem.hpp>
+//#include <boost/filesystem.hpp>
 #include <boost/filesystem/detail/utf8_codecvt_facet.hpp>
 namespace fs = boost::filesystem;
-#ifdef XPCF_WITH_LOGS
-namespace logging = boost::log;
-#endif
-
 namespace org { namespace bcom { namespace xpcf {
 
+XPCF_DEFINE_LOGGER("ComponentManager")
+
 std::atomic<ComponentManager*> ComponentManager::m_instance;
 std::mutex ComponentManager::m_mutex;
 
@@ -93,10 +90,7 @@ ComponentManager::ComponentManager():ComponentBase(toUUID<ComponentManager>()),m
     declareInterface<IComponentManager>(this);
     m_factory =  ComponentFactory::create<Factory>()->bindTo<AbstractFactory>();
     m_propertyManager =  m_factory->resolve<IPropertyManager>();
-#ifdef XPCF_WITH_LOGS
-    m_logger.add_attribute("ClassName", boost::log::attributes::constant<std::string>("ComponentManager"));
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Constructor ComponentManager::ComponentManager () called!";
-#endif
+    XPCF_LOG(info) << "Constructor ComponentManager::ComponentManager () called!";
 }
 
 uuids::uuid ComponentManager::getModuleUUID(const uuids::uuid & componentUUID) const
@@ -104,18 +98,9 @@ uuids::uuid ComponentManager::getModuleUUID(const uuids::uuid & componentUUID) c
     return m_factory->bindTo<IRegistryManager>()->getModuleUUID(componentUUID);
 }
 
-void ComponentManager::releaseComponent(uuids::uuid componentUUID)
-{
-    //Note : release the module ref, or count moduleref per component uuid to check ??
-    //Caution : no release must occur for bindLocal'd components
-    ModuleManager::instance()->releaseModuleRef(getModuleUUID(componentUUID));
-}
-
 void ComponentManager::unloadComponent ()
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"ComponentManager::unload () called!";
-#endif
+    XPCF_LOG(info) << "ComponentManager::unload () called!";
 }
 
 void ComponentManager::clear()
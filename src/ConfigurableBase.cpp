@@ -22,10 +22,8 @@
 
 #include "xpcf/component/ConfigurableBase.h"
 #include "private/xpcf/PropertyManager.h"
+#include "private/xpcf/Logger.h"
 #include <iostream>
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/attributes.hpp>
 #include <xpcf/collection/Collection.h>
 #include "private/xpcf/PropertyWrapper.h"
 #include "private/xpcf/PropertyMap.h"
@@ -33,10 +31,10 @@
 
 using namespace std;
 
-namespace logging = boost::log;
-
 namespace org { namespace bcom { namespace xpcf {
 
+XPCF_DEFINE_LOGGER("ConfigurableBase")
+
 // Primary template
 template<typename T>
 struct deduce_to
@@ -107,18 +105,11 @@ public:
     InternalImpl() {}
     ~InternalImpl() = default;
 
-#ifdef XPCF_WITH_LOGS
-    inline boost::log::sources::severity_logger< boost::log::trivial::severity_level > & getLogger() { return m_logger; }
-#endif
-
     inline SRef<IPropertyMap> getPropertyRootNode() const { return m_parameters; }
     SRef<PropertyMap> m_parameters = utils::make_shared<PropertyMap>();
     SRef<IPropertyManager> m_propsMgr;
 
 private:
-#ifdef XPCF_WITH_LOGS
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > m_logger;
-#endif
     InternalImpl(InternalImpl const &);
     InternalImpl & operator=(InternalImpl const &);
 
@@ -129,10 +120,7 @@ ConfigurableBase::ConfigurableBase(const uuids::uuid & uuid,
                                    const SRef<IPropertyMap> configuration)
     :ComponentBase(uuid), m_internalImpl(new InternalImpl())
 {
-#ifdef XPCF_WITH_LOGS
-    m_internalImpl->getLogger().add_attribute("ClassName", boost::log::attributes::constant<std::string>("ConfigurableBase"));
-    BOOST_LOG_SEV(m_internalImpl->getLogger(), logging::trivial::info)<<" ConfigurableBase::ConfigurableBase construction";
-#endif
+    XPCF_LOG(info) << " ConfigurableBase::ConfigurableBase construction";
     declareInterface<IConfigurable>(this);
     declareInjectable<IPropertyManager>(m_internalImpl->m_propsMgr);
 }
@@ -141,26 +129,19 @@ ConfigurableBase::ConfigurableBase(std::map<std::string,std::string> componentTr
                                    const SRef<IPropertyMap> configuration)
     :ComponentBase(componentTrait) ,m_internalImpl(new InternalImpl())
 {
-#ifdef XPCF_WITH_LOGS
-    m_internalImpl->getLogger().add_attribute("ClassName", boost::log::attributes::constant<std::string>("ConfigurableBase"));
-    BOOST_LOG_SEV(m_internalImpl->getLogger(), logging::trivial::info)<<" ConfigurableBase::ConfigurableBase construction";
-#endif
+    XPCF_LOG(info) << " ConfigurableBase::ConfigurableBase construction";
     declareInterface<IConfigurable>(this);
     declareInjectable<IPropertyManager>(m_internalImpl->m_propsMgr);
 }
 
 ConfigurableBase::~ConfigurableBase()
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_internalImpl->getLogger(), logging::trivial::info)<<" ConfigurableBase::~ConfigurableBase destruction";
-#endif
+    XPCF_LOG(info) << " ConfigurableBase::~ConfigurableBase destruction";
 }
 
 void ConfigurableBase::onInjected()
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_internalImpl->getLogger(), logging::trivial::info)<<" ConfigurableBase::onInjected IPropertyManager component address="<<m_internalImpl->m_propsMgr.get();
-#endif
+    XPCF_LOG(info) << " ConfigurableBase::onInjected IPropertyManager component address="<<m_internalImpl->m_propsMgr.get();
 }
 
 XPCFErrorCode ConfigurableBase::serialize(const char * filepath, uint32_t mode)
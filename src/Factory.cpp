@@ -22,12 +22,16 @@
 
 
 #include "private/xpcf/Factory.h"
+#include "private/xpcf/Logger.h"
 #include <xpcf/api/IModuleManager.h>
 #include <xpcf/core/ErrorMessage.h>
 #include <xpcf/core/Exception.h>
 #include <xpcf/core/helpers.h>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <set>
 #include "private/xpcf/PathBuilder.h"
+#include "private/xpcf/TaskPool.h"
 
 using namespace std;
 using placeholders::_1;
@@ -35,12 +39,10 @@ using placeholders::_2;
 
 XPCF_DEFINE_FACTORY_CREATE_INSTANCE(org::bcom::xpcf::Factory);
 
-#ifdef XPCF_WITH_LOGS
-namespace logging = boost::log;
-#endif
-
 namespace org { namespace bcom { namespace xpcf {
 
+XPCF_DEFINE_LOGGER("Factory")
+
 constexpr const char * XMLBINDINGSNODE = "bindings";
 constexpr const char * XMLBINDNODE = "bind";
 constexpr const char * XMLINJECTSNODE = "injects";
@@ -50,6 +52,9 @@ constexpr const char * XMLSCOPENODE = "scope";
 static const map<string,BindingScope> scopeConvertMap = {
     {"Transient",BindingScope::Transient},
     {"Singleton",BindingScope::Singleton},
+    {"Pooled",BindingScope::Pooled},
+    {"PerThread",BindingScope::PerThread},
+    {"Scoped",BindingScope::Scoped},
 };
 
 static const map<string,BindingRange> bindingRangeConvertMap = {
@@ -60,24 +65,225 @@ static const map<string,BindingRange> bindingRangeConvertMap = {
     {"withparents",BindingRange::WithParents}
 };
 
+FactoryContext::FactoryContext():m_bindings(utils::make_shared<const FactoryBindings>())
+{
+}
+
+FactoryContext::FactoryContext(const SRef<FactoryContext> & parent):m_parent(parent)
+{
+    SRef<FactoryBindings> bindings = utils::make_shared<FactoryBindings>();
+    bindings->parent = parent->bindings();
+    m_bindings = bindings;
+}
+
+SRef<const FactoryBindings> FactoryContext::bindings() const
+{
+    SRef<const FactoryBindings> bindings = utils::atomic_load(&m_bindings);
+    if (!m_parent) {
+        return bindings;
+    }
+    SRef<const FactoryBindings> parentBindings = m_parent->bindings();
+    if (bindings->parent == parentBindings) {
+        return bindings;
+    }
+    return rebase(parentBindings);
+}
+
+SRef<const FactoryBindings> FactoryContext::rebase(const SRef<const FactoryBindings> & parentBindings) const
+{
+    std::lock_guard<std::mutex> lock(m_updateMutex);
+    SRef<const FactoryBindings> bindings = utils::atomic_load(&m_bindings);
+    // another thread may already have rebased the snapshot upon a newer parent snapshot
+    if (bindings->parent && bindings->parent->revision >= parentBindings->revision) {
+        return bindings;
+    }
+    // only the local binds are copied
+    SRef<FactoryBindings> newBindings = utils::make_shared<FactoryBindings>(*bindings);
+    newBindings->parent = parentBindings;
+    newBindings->revision++;
+    utils::atomic_store(&m_bindings, SRef<const FactoryBindings>(newBindings));
+    return newBindings;
+}
+
+FactoryContext & FactoryContext::operator=(const FactoryContext & other)
+{
+    // snapshots are immutable : sharing the snapshot clones the bindings
+    SRef<const FactoryBindings> bindings = other.bindings();
+    std::lock_guard<std::mutex> lock(m_updateMutex);
+    uint64_t revision = utils::atomic_load(&m_bindings)->revision;
+    SRef<FactoryBindings> newBindings = utils::make_shared<FactoryBindings>(*bindings);
+    newBindings->revision = std::max(revision, bindings->revision) + 1;
+    utils::atomic_store(&m_bindings, SRef<const FactoryBindings>(newBindings));
+    return *this;
+}
+
+void FactoryContext::update(const std::function<void(FactoryBindings &)> & modifier)
+{
+    std::lock_guard<std::mutex> lock(m_updateMutex);
+    SRef<FactoryBindings> newBindings = utils::make_shared<FactoryBindings>(*utils::atomic_load(&m_bindings));
+    bool frozen = (newBindings->frozen != nullptr);
+    modifier(*newBindings);
+    if (frozen) {
+        newBindings->frozen = FrozenBindings::compile(*newBindings);
+    }
+    newBindings->revision++;
+    utils::atomic_store(&m_bindings, SRef<const FactoryBindings>(newBindings));
+}
+
+void FactoryContext::freeze()
+{
+    update([](FactoryBindings & bindings) {
+        bindings.frozen = FrozenBindings::compile(bindings);
+    });
+}
+
+SRef<const FrozenBindings> FrozenBindings::compile(const FactoryBindings & bindings)
+{
+    using BindEntries = std::vector<FlatHashTable<FactoryBindInfos>::Entry>;
+    SRef<FrozenBindings> frozen = utils::make_shared<FrozenBindings>();
+    auto compileBinds = [](const std::map<uuids::uuid, FactoryBindInfos> & binds) {
+        BindEntries entries;
+        entries.reserve(binds.size());
+        for (auto & [interfaceUUID, bindInfos] : binds) {
+            entries.push_back({interfaceUUID, uuids::uuid{}, std::string(), bindInfos});
+        }
+        return FlatHashTable<FactoryBindInfos>(std::move(entries));
+    };
+    frozen->autoBindings = compileBinds(bindings.autoBindings);
+    frozen->defaultBindings = compileBinds(bindings.defaultBindings);
+
+    std::vector<FlatHashTable<std::vector<FactoryBindInfos>>::Entry> multiEntries;
+    for (auto & [interfaceUUID, binds] : bindings.multiBindings) {
+        multiEntries.push_back({interfaceUUID, uuids::uuid{}, std::string(), binds});
+    }
+    frozen->multiBindings = FlatHashTable<std::vector<FactoryBindInfos>>(std::move(multiEntries));
+
+    BindEntries namedEntries;
+    for (auto & [key, bindInfos] : bindings.namedBindings) {
+        namedEntries.push_back({key.first, uuids::uuid{}, key.second, bindInfos});
+    }
+    frozen->namedBindings = FlatHashTable<FactoryBindInfos>(std::move(namedEntries));
+
+    std::vector<FlatHashTable<std::function<SRef<IComponentIntrospect>(void)>>::Entry> factoryEntries;
+    for (auto & [componentUUID, factoryMethod] : bindings.factoryMethods) {
+        factoryEntries.push_back({componentUUID, uuids::uuid{}, std::string(), factoryMethod});
+    }
+    frozen->factoryMethods = FlatHashTable<std::function<SRef<IComponentIntrospect>(void)>>(std::move(factoryEntries));
+
+    BindEntries specificEntries;
+    for (auto & [targetComponentUUID, binds] : bindings.specificBindings) {
+        for (auto & [interfaceUUID, bindInfos] : binds) {
+            specificEntries.push_back({targetComponentUUID, interfaceUUID, std::string(), bindInfos});
+        }
+    }
+    frozen->specificBindings = FlatHashTable<FactoryBindInfos>(std::move(specificEntries));
+
+    BindEntries specificNamedEntries;
+    for (auto & [targetComponentUUID, binds] : bindings.specificNamedBindings) {
+        for (auto & [key, bindInfos] : binds) {
+            specificNamedEntries.push_back({targetComponentUUID, key.first, key.second, bindInfos});
+        }
+    }
+    frozen->specificNamedBindings = FlatHashTable<FactoryBindInfos>(std::move(specificNamedEntries));
+    return frozen;
+}
+
+template <typename K, typename V> static const V * findValue(const std::map<K, V> & map, const K & key)
+{
+    auto it = map.find(key);
+    return (it != map.end()) ? &it->second : nullptr;
+}
+
+// searches the bindings levels, from the overlay context bindings up to the root context bindings
+template <typename T, typename F> static const T * findInLevels(const FactoryBindings & bindings, F find)
+{
+    for (const FactoryBindings * level = &bindings; level != nullptr; level = level->parent.get()) {
+        const T * value = find(*level);
+        if (value != nullptr) {
+            return value;
+        }
+    }
+    return nullptr;
+}
+
+const FactoryBindInfos * FactoryBindings::findAutoBind(const uuids::uuid & interfaceUUID) const
+{
+    return findInLevels<FactoryBindInfos>(*this, [&interfaceUUID](const FactoryBindings & level) {
+        return level.frozen ? level.frozen->autoBindings.find(interfaceUUID) : findValue(level.autoBindings, interfaceUUID);
+    });
+}
+
+const FactoryBindInfos * FactoryBindings::findDefaultBind(const uuids::uuid & interfaceUUID) const
+{
+    return findInLevels<FactoryBindInfos>(*this, [&interfaceUUID](const FactoryBindings & level) {
+        return level.frozen ? level.frozen->defaultBindings.find(interfaceUUID) : findValue(level.defaultBindings, interfaceUUID);
+    });
+}
+
+const std::vector<FactoryBindInfos> * FactoryBindings::findMultiBinds(const uuids::uuid & interfaceUUID) const
+{
+    return findInLevels<std::vector<FactoryBindInfos>>(*this, [&interfaceUUID](const FactoryBindings & level) {
+        return level.frozen ? level.frozen->multiBindings.find(interfaceUUID) : findValue(level.multiBindings, interfaceUUID);
+    });
+}
+
+const FactoryBindInfos * FactoryBindings::findNamedBind(const uuids::uuid & interfaceUUID, const std::string & name) const
+{
+    return findInLevels<FactoryBindInfos>(*this, [&interfaceUUID, &name](const FactoryBindings & level) {
+        return level.frozen ? level.frozen->namedBindings.find(interfaceUUID, name) : findValue(level.namedBindings, make_pair(interfaceUUID, name));
+    });
+}
+
+const std::function<SRef<IComponentIntrospect>(void)> * FactoryBindings::findFactoryMethod(const uuids::uuid & componentUUID) const
+{
+    return findInLevels<std::function<SRef<IComponentIntrospect>(void)>>(*this, [&componentUUID](const FactoryBindings & level) {
+        return level.frozen ? level.frozen->factoryMethods.find(componentUUID) : findValue(level.factoryMethods, componentUUID);
+    });
+}
+
+const FactoryBindInfos * FactoryBindings::findSpecificBind(const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID) const
+{
+    return findInLevels<FactoryBindInfos>(*this, [&targetComponentUUID, &interfaceUUID](const FactoryBindings & level) -> const FactoryBindInfos * {
+        if (level.frozen) {
+            return level.frozen->specificBindings.find(targetComponentUUID, interfaceUUID);
+        }
+        auto specificBindingsIt = level.specificBindings.find(targetComponentUUID);
+        if (specificBindingsIt == level.specificBindings.end()) {
+            return nullptr;
+        }
+        return findValue(specificBindingsIt->second, interfaceUUID);
+    });
+}
+
+const FactoryBindInfos * FactoryBindings::findSpecificNamedBind(const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID,
+                                                               const std::string & name) const
+{
+    return findInLevels<FactoryBindInfos>(*this, [&targetComponentUUID, &interfaceUUID, &name](const FactoryBindings & level) -> const FactoryBindInfos * {
+        if (level.frozen) {
+            return level.frozen->specificNamedBindings.find(targetComponentUUID, interfaceUUID, name);
+        }
+        auto specificBindingsIt = level.specificNamedBindings.find(targetComponentUUID);
+        if (specificBindingsIt == level.specificNamedBindings.end()) {
+            return nullptr;
+        }
+        return findValue(specificBindingsIt->second, make_pair(interfaceUUID, name));
+    });
+}
+
 void FactoryContext::clear()
 {
-    autoBindings.clear();
-    defaultBindings.clear();
-    multiBindings.clear();
-    namedBindings.clear();
-    namedBindingsProperties.clear();
-    bindingsProperties.clear();
-    multiBindingsProperties.clear();
-    factoryMethods.clear();
-    specificBindings.clear();
-    specificNamedBindings.clear();
+    update([](FactoryBindings & bindings) {
+        uint64_t revision = bindings.revision;
+        bindings = FactoryBindings();
+        bindings.revision = revision;
+    });
 }
 
 Factory::Factory():ComponentBase(toUUID<Factory>())
 {
     // bind structures must exist prior to Factory inner binds
     m_context = utils::make_shared<FactoryContext>() ;
+    m_perThreadRegistry = utils::make_shared<PerThreadRegistry>();
 
     declareInterface<IFactory>(this);
     declareInterface<AbstractFactory>(this);
@@ -94,10 +300,36 @@ Factory::Factory():ComponentBase(toUUID<Factory>())
         autobind(interfaceUUID,componentUUID);
     };
     m_resolver->bindTo<AbstractRegistry>()->setBinder(bindFunc);
-#ifdef XPCF_WITH_LOGS
-    m_logger.add_attribute("ClassName", boost::log::attributes::constant<std::string>("Factory"));
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Constructor Factory::Factory () called!";
-#endif
+    XPCF_LOG(info) << "Constructor Factory::Factory () called!";
+}
+
+Factory::Factory(const Factory * parent, ContextMode ctxMode):ComponentBase(toUUID<Factory>())
+{
+    if (ctxMode == ContextMode::Overlay) {
+        m_context = utils::make_shared<FactoryContext>(parent->m_context);
+        m_perThreadRegistry = utils::make_shared<PerThreadRegistry>();
+        m_overlay = true;
+    }
+    else {
+        // a scope resolves the bindings of its parent with the parent resolution plans, and shares its per thread instances
+        m_context = parent->m_context;
+        m_root = parent->m_root;
+        m_perThreadRegistry = parent->m_perThreadRegistry;
+    }
+
+    declareInterface<IFactory>(this);
+    declareInterface<AbstractFactory>(this);
+    declareInterface<IAliasManager>(this);
+    declareInterface<IRegistryManager>(this);
+
+    // core components are shared with the parent factory instead of being created again
+    m_coreBindings = parent->m_coreBindings;
+    m_coreFactoryMethods = parent->m_coreFactoryMethods;
+    m_coreInstances = parent->m_coreInstances;
+    m_propertyManager = parent->m_propertyManager;
+    m_aliasManager = parent->m_aliasManager;
+    m_resolver = parent->m_resolver;
+    XPCF_LOG(info) << "Constructor Factory::Factory (child) called!";
 }
 
 #ifdef XPCF_WITH_LOGS
@@ -136,6 +368,25 @@ std::stringstream Factory::log(const FactoryBindInfos & bindInfos)
 // the context can be shared from xpcf main factory, or dedicated to this new factory context and in this case empty
 // however, if the context is empty, how can the user populate the registry, aliases, props as the factory has no load method and for the moment doesn't provide access to its inner components ..?
 SRef<IFactory> Factory::createNewFactoryContext(ContextMode ctxMode)
+{
+    return createFactory(ctxMode)->introspect()->bindTo<IFactory>();
+}
+
+SRef<IFactory> Factory::createScope()
+{
+    // the scope only owns its scoped instances : the context, the core components and the resolution plans are the parent ones
+    Factory * f = new Factory(this, ContextMode::Shared);
+    // the scope keeps its parent alive : the singletons are resolved from the parent
+    f->m_parentRef = bindTo<IFactory>();
+    f->m_parent = this;
+    f->m_parallelInjection = m_parallelInjection.load();
+    f->setAsyncExecutor(asyncExecutor());
+    utils::atomic_store(&f->m_footprintRecorder, utils::atomic_load(&m_footprintRecorder));
+    f->m_footprintEnabled = m_footprintEnabled.load();
+    return f->introspect()->bindTo<IFactory>();
+}
+
+Factory * Factory::createFactory(ContextMode ctxMode)
 {
 #ifdef XPCF_WITH_LOGS
     std::string mode;
@@ -146,12 +397,14 @@ SRef<IFactory> Factory::createNewFactoryContext(ContextMode ctxMode)
         break;
     case ContextMode::Shared : mode = "shared";
         break;
+    case ContextMode::Overlay : mode = "overlay";
+        break;
     default:
         break;
     }
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Factory::createNewFactoryContext with mode="<<mode;
+    XPCF_LOG(info) << "Factory::createNewFactoryContext with mode="<<mode;
 #endif
-    Factory * f = new Factory();
+    Factory * f = (ctxMode == ContextMode::Overlay) ? new Factory(this, ctxMode) : new Factory();
     if (ctxMode == ContextMode::Cloned) {
         // TODO clone alias, props informations
         // for the moment, the propertymanager & alias mgr are shared between factories when context is cloned.
@@ -159,6 +412,12 @@ SRef<IFactory> Factory::createNewFactoryContext(ContextMode ctxMode)
         *(f->m_aliasManager->context()) = *(m_aliasManager->getContext());
         *(f->m_resolver->context()) = *(m_resolver->getContext());
         *(f->m_context) = *m_context;
+        f->m_parallelInjection = m_parallelInjection.load();
+        f->setAsyncExecutor(asyncExecutor());
+    }
+    if (ctxMode == ContextMode::Overlay) {
+        f->m_parallelInjection = m_parallelInjection.load();
+        f->setAsyncExecutor(asyncExecutor());
     }
     if (ctxMode == ContextMode::Shared) {
         f->m_propertyManager->setContext(m_propertyManager->getContext());
@@ -166,25 +425,268 @@ SRef<IFactory> Factory::createNewFactoryContext(ContextMode ctxMode)
         f->m_resolver->setContext(m_resolver->getContext());
 
         f->m_context = m_context;
+        f->m_parallelInjection = m_parallelInjection.load();
+        f->setAsyncExecutor(asyncExecutor());
+    }
+    utils::atomic_store(&f->m_footprintRecorder, utils::atomic_load(&m_footprintRecorder));
+    f->m_footprintEnabled = m_footprintEnabled.load();
+    return f;
+}
+
+void Factory::setAsyncExecutor(const AsyncExecutor & executor)
+{
+    std::lock_guard<std::mutex> lock(m_asyncExecutorMutex);
+    m_asyncExecutor = executor;
+}
+
+AsyncExecutor Factory::asyncExecutor() const
+{
+    std::lock_guard<std::mutex> lock(m_asyncExecutorMutex);
+    return m_asyncExecutor;
+}
+
+void Factory::executeAsync(const std::function<void(void)> & task)
+{
+    AsyncExecutor executor = asyncExecutor();
+    if (executor) {
+        executor(task);
+    }
+    else {
+        TaskPool::instance().post(task);
+    }
+}
+
+std::vector<SingletonWarmupInfos> Factory::warmup()
+{
+    SRef<const FactoryBindings> bindings = m_context->bindings();
+    std::vector<SingletonWarmupInfos> report;
+    std::vector<FactoryBindInfos> reportBinds;
+    std::vector<std::function<void(void)>> resolutions;
+    // a singleton bound to several interfaces is instantiated once
+    std::set<std::pair<uuids::uuid,std::string>> singletons;
+    auto declare = [&](const uuids::uuid & interfaceUUID, const std::string & name, const FactoryBindInfos & bindInfos,
+                       const std::function<void(void)> & resolution) {
+        if (bindInfos.scope != BindingScope::Singleton || !singletons.insert(make_pair(bindInfos.componentUUID, name)).second) {
+            return;
+        }
+        report.push_back(SingletonWarmupInfos{interfaceUUID, name, bindInfos.componentUUID, std::chrono::microseconds(0)});
+        reportBinds.push_back(bindInfos);
+        resolutions.push_back(resolution);
+    };
+    // overlay contexts : the binds of each level are instantiated unless a closer level overrides them
+    for (const FactoryBindings * level = bindings.get(); level != nullptr; level = level->parent.get()) {
+        for (auto & [interfaceUUID, bindInfos] : level->defaultBindings) {
+            const uuids::uuid & uuid = interfaceUUID;
+            if (*bindings->findDefaultBind(uuid) == bindInfos) {
+                declare(uuid, "", bindInfos, [this, uuid]() { resolve(uuid); });
+            }
+        }
+        for (auto & [key, bindInfos] : level->namedBindings) {
+            const std::pair<uuids::uuid,std::string> & bindKey = key;
+            if (*bindings->findNamedBind(bindKey.first, bindKey.second) == bindInfos) {
+                declare(bindKey.first, bindKey.second, bindInfos, [this, bindKey]() { resolve(bindKey.first, bindKey.second); });
+            }
+        }
+        for (auto & [interfaceUUID, binds] : level->multiBindings) {
+            if (*bindings->findMultiBinds(interfaceUUID) != binds) {
+                continue;
+            }
+            for (const FactoryBindInfos & bindInfos : binds) {
+                const FactoryBindInfos * multiBind = &bindInfos;
+                declare(interfaceUUID, "", bindInfos, [this, bindings, multiBind]() {
+                    BindContext context{ContextType::Component, *multiBind, nullptr};
+                    resolveInstance(*multiBind, "", *bindings, context, nullptr);
+                });
+            }
+        }
+    }
+
+    // singletons instantiation order follows their dependencies through the singleton holders
+    TaskGroup group;
+    for (auto & resolution : resolutions) {
+        group.run(resolution);
+    }
+    try {
+        group.wait();
     }
-    return IComponentIntrospect::acquireComponentRef<Factory, IComponentIntrospect>(f)->bindTo<IFactory>();
+    catch (const ConfigurationException &) {
+        throw;
+    }
+    catch (const xpcf::Exception & e) {
+        throw ConfigurationException(e.what());
+    }
+    for (std::size_t i = 0; i < report.size(); i++) {
+        report[i].duration = singletonInstance(reportBinds[i], report[i].name)->duration();
+        XPCF_LOG(info) << "Factory::warmup singleton component uuid="<<uuids::to_string(report[i].componentUUID)
+                       <<" name="<<report[i].name<<" created in "<<report[i].duration.count()<<"us";
+    }
+    return report;
+}
+
+void Factory::enableFootprintReport(bool enable, AllocatedBytesCounter counter)
+{
+    m_footprintEnabled = false;
+    utils::atomic_store(&m_footprintRecorder, enable ? utils::make_shared<FootprintRecorder>(counter) : SRef<FootprintRecorder>());
+    m_footprintEnabled = enable;
+}
+
+std::vector<ComponentFootprint> Factory::footprintReport() const
+{
+    SRef<FootprintRecorder> recorder = utils::atomic_load(&m_footprintRecorder);
+    if (!recorder) {
+        return std::vector<ComponentFootprint>();
+    }
+    std::vector<ComponentFootprint> report = recorder->report();
+    for (ComponentFootprint & footprint : report) {
+        // core components and components bound to a factory method don't belong to a registered module
+        try {
+            SPtr<ComponentMetadata> componentInfos = findComponentMetadata(footprint.componentUUID);
+            if (componentInfos) {
+                footprint.name = componentInfos->name();
+            }
+        }
+        catch (const std::exception &) {
+        }
+    }
+    return report;
+}
+
+SRef<FootprintRecorder> Factory::footprintRecorder() const
+{
+    // constructions don't load the recorder reference while the report is disabled
+    return m_footprintEnabled ? utils::atomic_load(&m_footprintRecorder) : SRef<FootprintRecorder>();
+}
+
+std::vector<BatchResolution> Factory::resolveMany(const std::vector<std::pair<uuids::uuid,std::string>> & requests, bool parallel)
+{
+    // the whole batch is resolved upon the same bindings snapshot
+    SRef<const FactoryBindings> bindings = m_context->bindings();
+    std::vector<BatchResolution> batch;
+    batch.reserve(requests.size());
+    // index of the request resolving the shared instance of each request
+    std::vector<std::size_t> sharedWith(requests.size());
+    std::map<std::pair<uuids::uuid,std::string>, std::size_t> sharedInstances;
+    std::vector<std::size_t> resolutions;
+    for (std::size_t i = 0; i < requests.size(); i++) {
+        const auto & [interfaceUUID, name] = requests[i];
+        batch.push_back(BatchResolution{interfaceUUID, name, nullptr, nullptr});
+        sharedWith[i] = i;
+        try {
+            const FactoryBindInfos & bindInfos = name.empty() ? resolveBind(interfaceUUID, *bindings, nullptr)
+                                                              : resolveBind(interfaceUUID, name, *bindings, nullptr);
+            if (bindInfos.scope == BindingScope::Singleton || (bindInfos.scope == BindingScope::Scoped && m_parent != nullptr)) {
+                auto [it, inserted] = sharedInstances.emplace(requests[i], i);
+                sharedWith[i] = it->second;
+                if (!inserted) {
+                    continue;
+                }
+            }
+        }
+        catch (const xpcf::Exception &) {
+            // the resolution reports the error
+        }
+        resolutions.push_back(i);
+    }
+
+    auto resolveRequest = [this, &batch, &bindings](std::size_t i) {
+        try {
+            batch[i].component = resolveFromPlan(batch[i].interfaceUUID, batch[i].name, bindings);
+        }
+        catch (...) {
+            batch[i].error = std::current_exception();
+        }
+    };
+    if (parallel && resolutions.size() > 1) {
+        TaskGroup group;
+        for (std::size_t i : resolutions) {
+            group.run([&resolveRequest, i]() { resolveRequest(i); });
+        }
+        group.wait();
+    }
+    else {
+        for (std::size_t i : resolutions) {
+            resolveRequest(i);
+        }
+    }
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        if (sharedWith[i] != i) {
+            batch[i].component = batch[sharedWith[i]].component;
+            batch[i].error = batch[sharedWith[i]].error;
+        }
+    }
+    return batch;
+}
+
+result<SRef<IComponentIntrospect>, XPCFErrorCode> Factory::tryResolve(const uuids::uuid & interfaceUUID)
+{
+    return tryResolve(interfaceUUID, "");
+}
+
+result<SRef<IComponentIntrospect>, XPCFErrorCode> Factory::tryResolve(const uuids::uuid & interfaceUUID, const std::string & name)
+{
+    SRef<const FactoryBindings> bindings = m_context->bindings();
+    BindResult bind = name.empty() ? tryResolveBind(interfaceUUID, *bindings, nullptr) : tryResolveBind(interfaceUUID, name, *bindings, nullptr);
+    if (bind.hasError()) {
+        return result<SRef<IComponentIntrospect>, XPCFErrorCode>(SRef<IComponentIntrospect>(), "Factory::tryResolve", bind.errCode());
+    }
+    return result<SRef<IComponentIntrospect>, XPCFErrorCode>(resolveFromPlan(interfaceUUID, name, bindings), "", XPCFErrorCode::_SUCCESS);
 }
 
 void Factory::clear()
 {
+    if (m_parent != nullptr) {
+        // the bindings and the core components of a scope belong to its parent
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        m_scopedInstances.clear();
+        return;
+    }
     m_context->clear();
-    m_singletonInstances.clear();
-    m_namedSingletonInstances.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        m_singletonInstances.clear();
+        m_namedSingletonInstances.clear();
+        m_scopedInstances.clear();
+    }
+    m_perThreadRegistry->clear();
+    {
+        // the plans recorded upon the cleared bindings are dropped with them
+        std::lock_guard<std::mutex> lock(m_resolutionPlansMutex);
+        utils::atomic_store(&m_resolutionPlans, SRef<const ResolutionPlanTable>(utils::make_shared<ResolutionPlanTable>()));
+    }
+    if (m_overlay) {
+        // the core components belong to the parent factory
+        return;
+    }
     m_propertyManager->clear();
     m_aliasManager->clear();
     m_resolver->clear();
 }
 
+// creates, injects and configures a component, measuring each step for the footprint report when recorder is set.
+// inject returns false when the component can't be injected : the component is then dropped and nothing is recorded
+template <typename Create, typename Inject, typename Configure>
+static SRef<IComponentIntrospect> constructComponent(FootprintRecorder * recorder, const uuids::uuid & componentUUID,
+                                                     Create && create, Inject && inject, Configure && configure)
+{
+    FootprintScope footprint(recorder);
+    footprint.start();
+    SRef<IComponentIntrospect> componentRef = create();
+    footprint.stop(FootprintScope::Phase::Creation);
+    footprint.start();
+    if (!inject(componentRef)) {
+        return SRef<IComponentIntrospect>();
+    }
+    footprint.stop(FootprintScope::Phase::Injection);
+    footprint.start();
+    configure(componentRef);
+    footprint.stop(FootprintScope::Phase::Configuration);
+    footprint.commit(componentUUID);
+    return componentRef;
+}
+
 SRef<IComponentIntrospect> Factory::create(const uuids::uuid & componentUUID)
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"ComponentManager::create uuid="<<uuids::to_string(componentUUID);
-#endif
+    XPCF_LOG(info) << "ComponentManager::create uuid="<<uuids::to_string(componentUUID);
     SPtr<ModuleMetadata> moduleInfos = findModuleMetadata(getModuleUUID(componentUUID));
     SRef<IComponentIntrospect> componentRef = getModuleManagerInstance()->createComponent(moduleInfos, componentUUID);
     return componentRef;
@@ -192,34 +694,40 @@ SRef<IComponentIntrospect> Factory::create(const uuids::uuid & componentUUID)
 
 SRef<IComponentIntrospect> Factory::createComponent(const uuids::uuid & componentUUID)
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"ComponentManager::createComponent uuid="<<uuids::to_string(componentUUID);
-#endif
-    SRef<IComponentIntrospect> componentRef = create(componentUUID);
-    inject(componentRef->bindTo<IInjectable>());
-
-    fs::path configFilePath = m_propertyManager->getConfigPath(componentUUID);
-    if (componentRef->implements<IConfigurable>() && ! configFilePath.empty()) {
-        SRef<IConfigurable> iconf = componentRef->bindTo<IConfigurable>();
-        iconf->configure(configFilePath.string().c_str());
-    }
-    return componentRef;
+    XPCF_LOG(info) << "ComponentManager::createComponent uuid="<<uuids::to_string(componentUUID);
+    SRef<FootprintRecorder> recorder = footprintRecorder();
+    return constructComponent(recorder.get(), componentUUID,
+        [this, &componentUUID]() { return create(componentUUID); },
+        [this](const SRef<IComponentIntrospect> & componentRef) {
+            inject(componentRef->bindTo<IInjectable>());
+            return true;
+        },
+        [this, &componentUUID](const SRef<IComponentIntrospect> & componentRef) {
+            fs::path configFilePath = m_propertyManager->getConfigPath(componentUUID);
+            if (componentRef->implements<IConfigurable>() && ! configFilePath.empty()) {
+                SRef<IConfigurable> iconf = componentRef->bindTo<IConfigurable>();
+                iconf->configure(configFilePath.string().c_str());
+            }
+        });
 }
 
 SRef<IComponentIntrospect> Factory::createComponent(const char * instanceName, const uuids::uuid & componentUUID)
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"ComponentManager::createComponent name="<<instanceName<<" uuid="<<uuids::to_string(componentUUID);
-#endif
-    SRef<IComponentIntrospect> componentRef = create(componentUUID);
-    inject(componentRef->bindTo<IInjectable>());
-
-    fs::path configFilePath = m_propertyManager->getConfigPath(componentUUID);
-    if (componentRef->implements<IConfigurable>() && ! configFilePath.empty()) {
-        SRef<IConfigurable> iconf = componentRef->bindTo<IConfigurable>();
-        iconf->configure(configFilePath.string().c_str(), instanceName);
-    }
-    return componentRef;
+    XPCF_LOG(info) << "ComponentManager::createComponent name="<<instanceName<<" uuid="<<uuids::to_string(componentUUID);
+    SRef<FootprintRecorder> recorder = footprintRecorder();
+    return constructComponent(recorder.get(), componentUUID,
+        [this, &componentUUID]() { return create(componentUUID); },
+        [this](const SRef<IComponentIntrospect> & componentRef) {
+            inject(componentRef->bindTo<IInjectable>());
+            return true;
+        },
+        [this, instanceName, &componentUUID](const SRef<IComponentIntrospect> & componentRef) {
+            fs::path configFilePath = m_propertyManager->getConfigPath(componentUUID);
+            if (componentRef->implements<IConfigurable>() && ! configFilePath.empty()) {
+                SRef<IConfigurable> iconf = componentRef->bindTo<IConfigurable>();
+                iconf->configure(configFilePath.string().c_str(), instanceName);
+            }
+        });
 }
 
 XPCFErrorCode Factory::load()
@@ -336,15 +844,15 @@ XPCFErrorCode Factory::loadLibrary(fs::path configurationFilePath)
     }
 
     XPCFErrorCode result = XPCFErrorCode::_FAIL;
+    // the library can declare new configurations : outdate existing resolution plans
+    m_context->update([](FactoryBindings &) {});
     tinyxml2::XMLDocument doc;
     enum tinyxml2::XMLError loadOkay = doc.LoadFile(configurationFilePath.string().c_str());
     if (loadOkay == 0) {
         std::string what = "configuration loading failed: ";
         try {
-#ifdef XPCF_WITH_LOGS
-            BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Parsing XML from "<<configurationFilePath<<" config file";
-            BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"NOTE : Command line arguments are overloaded with config file parameters";
-#endif
+            XPCF_LOG(info) << "Parsing XML from "<<configurationFilePath<<" config file";
+            XPCF_LOG(info) << "NOTE : Command line arguments are overloaded with config file parameters";
             //TODO : check each element exists before using it !
             // a check should be performed upon announced module uuid and inner module uuid
             // check xml node is xpcf-registry first !
@@ -369,15 +877,21 @@ XPCFErrorCode Factory::loadLibrary(fs::path configurationFilePath)
             processXmlNode<const fs::path &>(rootElt, "configuration", declareConfigureFunc, configurationFilePath);
             std::function<void(tinyxml2::XMLElement*,  const fs::path &)> declarePropertiesFunc = std::bind(&AbstractPropertyManager::declareProperties,  m_propertyManager->bindTo<AbstractPropertyManager>().get(), _1,_2);
             processXmlNode<const fs::path &>(rootElt, "properties", declarePropertiesFunc, configurationFilePath);
+            const char * prefetchModulesAttr = rootElt->Attribute("prefetchModules");
+            if (prefetchModulesAttr != nullptr && string(prefetchModulesAttr) == "true") {
+                processXmlNode(rootElt, "module", std::bind(&Factory::prefetchModule, this, _1));
+            }
+            const char * warmupAttr = rootElt->Attribute("warmup");
+            if (warmupAttr != nullptr && string(warmupAttr) == "true") {
+                warmup();
+            }
         }
         catch (const xpcf::Exception & e) {
             what.append(e.what());
             throw ConfigurationException(what);
         }
         catch (const std::runtime_error & e) {
-#ifdef XPCF_WITH_LOGS
-            BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"XML parsing file "<<configurationFilePath<<" failed with error : "<<e.what();
-#endif
+            XPCF_LOG(info) << "XML parsing file "<<configurationFilePath<<" failed with error : "<<e.what();
             return XPCFErrorCode::_FAIL;
         }
     }
@@ -412,6 +926,17 @@ FactoryBindInfos Factory::getComponentBindingInfos(tinyxml2::XMLElement * xmlBin
     if (scopeType != nullptr) {
         infos.scope = scopeConvertMap.at(scopeType);
     }
+    const char * poolSize =  xmlBindElt->Attribute("poolSize");
+    if (poolSize != nullptr) {
+        try {
+            infos.poolSize = std::stoul(poolSize);
+        }
+        catch(const std::exception& ) {
+            std::string what = "Invalid \"poolSize\" attribute value ";
+            what.append(poolSize);
+            throw ConfigurationException(what);
+        }
+    }
     const char * propertiesName =  xmlBindElt->Attribute("properties");
     if (propertiesName != nullptr) {
         infos.properties = propertiesName;
@@ -445,13 +970,17 @@ void Factory::declareSingleBind(const uuids::uuid & interfaceUUID, tinyxml2::XML
 void Factory::declareMultiBind(const uuids::uuid & interfaceUUID, tinyxml2::XMLElement * xmlBindElt)
 {
     tinyxml2::XMLElement *element = xmlBindElt->FirstChildElement("component");
-    VectorCollection<FactoryBindInfos> & binds = m_context->multiBindings[interfaceUUID];
+    std::vector<FactoryBindInfos> binds;
     while (element != nullptr) {
         FactoryBindInfos infos = getComponentBindingInfos(element);
         infos.bindingRangeMask |= BindingRange::Default;
-        binds.add(infos);
+        binds.push_back(infos);
         element = element->NextSiblingElement("component");
     }
+    m_context->update([&interfaceUUID, &binds](FactoryBindings & bindings) {
+        std::vector<FactoryBindInfos> & multiBinds = bindings.multiBindings[interfaceUUID];
+        multiBinds.insert(multiBinds.end(), binds.begin(), binds.end());
+    });
 }
 
 void Factory::declareBind(tinyxml2::XMLElement * xmlBindElt)
@@ -606,8 +1135,16 @@ void Factory::declareInjects(tinyxml2::XMLElement * xmlInjectsElt)
 void Factory::declareFactory(tinyxml2::XMLElement * xmlFactoryElt)
 {
     try {
+        const char * parallelInjectionAttr = xmlFactoryElt->Attribute("parallelInjection");
+        if (parallelInjectionAttr != nullptr) {
+            m_parallelInjection = (string(parallelInjectionAttr) == "true");
+        }
         processXmlNode(xmlFactoryElt, XMLBINDINGSNODE, std::bind(&Factory::declareBindings, this, _1));
         processXmlNode(xmlFactoryElt, XMLINJECTSNODE, std::bind(&Factory::declareInjects, this, _1));
+        const char * freezeAttr = xmlFactoryElt->Attribute("freeze");
+        if (freezeAttr != nullptr && string(freezeAttr) == "true") {
+            m_context->freeze();
+        }
     }
     catch (const xpcf::Exception& e) {
         XmlErrorMessage errMsg("factory", e.what(), true);
@@ -615,6 +1152,16 @@ void Factory::declareFactory(tinyxml2::XMLElement * xmlFactoryElt)
     }
 }
 
+void Factory::prefetchModule(tinyxml2::XMLElement * xmlModuleElt)
+{
+    const char * moduleUuidAttr = xmlModuleElt->Attribute("uuid");
+    if (moduleUuidAttr == nullptr) {
+        return;
+    }
+    // the module was declared by the same file
+    getModuleManagerInstance()->prefetchModule(m_resolver->findModuleMetadata(toUUID(moduleUuidAttr)));
+}
+
 SRef<IComponentIntrospect> Factory::resolveFromModule(const uuids::uuid & componentUUID)
 {
     SPtr<ModuleMetadata> moduleInfos = resolveMetadataFromComponentUUID(componentUUID);
@@ -624,10 +1171,12 @@ SRef<IComponentIntrospect> Factory::resolveFromModule(const uuids::uuid & compon
 
 void Factory::autobind(const uuids::uuid & interfaceUUID, const uuids::uuid & instanceUUID)
 {
-    if (! mapContains(m_context->defaultBindings,interfaceUUID)) {
-        // no explicit bind already exists : add autobind
-        m_context->autoBindings[interfaceUUID] = FactoryBindInfos{instanceUUID, BindingScope::Transient, BindingRange::All, ""};
-    }
+    m_context->update([&interfaceUUID, &instanceUUID](FactoryBindings & bindings) {
+        if (! mapContains(bindings.defaultBindings,interfaceUUID)) {
+            // no explicit bind already exists : add autobind
+            bindings.autoBindings[interfaceUUID] = FactoryBindInfos{instanceUUID, BindingScope::Transient, BindingRange::All, ""};
+        }
+    });
 }
 
 void Factory::bindCore(const uuids::uuid & interfaceUUID, const FactoryBindInfos & bindInfos)
@@ -646,17 +1195,54 @@ template < typename I, typename C, BindingScope scope> void Factory::bindCore()
     m_coreFactoryMethods[componentUUID] = &ComponentFactory::create<C>;
 }
 
-void Factory::bind(const uuids::uuid & interfaceUUID, const FactoryBindInfos & bindInfos)
+// the bind insertions are shared by the binds with and without factory method :
+// a bind and its factory method are published by the same context update
+static void insertBind(FactoryBindings & bindings, const uuids::uuid & interfaceUUID, const FactoryBindInfos & bindInfos)
 {
-    if (mapContains(m_context->defaultBindings,interfaceUUID)) {
+    if (mapContains(bindings.defaultBindings,interfaceUUID)) {
         // bind already exists : error ???
         // should we return or update the bind ?
     }
-    if (mapContains(m_context->autoBindings,interfaceUUID)) {
+    if (mapContains(bindings.autoBindings,interfaceUUID)) {
         // remove autobind as an explicit bind is added
-        m_context->autoBindings.erase(interfaceUUID);
+        bindings.autoBindings.erase(interfaceUUID);
     }
-    m_context->defaultBindings[interfaceUUID] = bindInfos;
+    bindings.defaultBindings[interfaceUUID] = bindInfos;
+}
+
+static void insertBind(FactoryBindings & bindings, const std::string & name, const uuids::uuid & interfaceUUID,
+                       const FactoryBindInfos & bindInfos)
+{
+    pair<uuids::uuid,string> key = make_pair(interfaceUUID,name);
+    if (mapContains(bindings.namedBindings,key)) {
+        // bind already exists : error ???
+    }
+    bindings.namedBindings[key] = bindInfos;
+}
+
+static void insertBind(FactoryBindings & bindings, const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID,
+                       const FactoryBindInfos & bindInfos)
+{
+    if (mapContains(bindings.specificBindings,targetComponentUUID)) {
+        // bind already exists : error ???
+    }
+    bindings.specificBindings[targetComponentUUID][interfaceUUID] = bindInfos;
+}
+
+static void insertBind(FactoryBindings & bindings, const uuids::uuid & targetComponentUUID, const std::string & name,
+                       const uuids::uuid & interfaceUUID, const FactoryBindInfos & bindInfos)
+{
+    if (mapContains(bindings.specificNamedBindings,targetComponentUUID)) {
+        // bind already exists : error ???
+    }
+    bindings.specificNamedBindings[targetComponentUUID][ make_pair(interfaceUUID,name)] = bindInfos;
+}
+
+void Factory::bind(const uuids::uuid & interfaceUUID, const FactoryBindInfos & bindInfos)
+{
+    m_context->update([&interfaceUUID, &bindInfos](FactoryBindings & bindings) {
+        insertBind(bindings, interfaceUUID, bindInfos);
+    });
 }
 
 void Factory::bind(const uuids::uuid & interfaceUUID, const uuids::uuid & instanceUUID,
@@ -670,11 +1256,9 @@ void Factory::bind(const uuids::uuid & interfaceUUID, const uuids::uuid & instan
 void Factory::bind(const std::string & name, const uuids::uuid & interfaceUUID,
                    const FactoryBindInfos & bindInfos)
 {
-    pair<uuids::uuid,string> key = make_pair(interfaceUUID,name);
-    if (mapContains(m_context->namedBindings,key)) {
-        // bind already exists : error ???
-    }
-    m_context->namedBindings[key] = bindInfos;
+    m_context->update([&name, &interfaceUUID, &bindInfos](FactoryBindings & bindings) {
+        insertBind(bindings, name, interfaceUUID, bindInfos);
+    });
 }
 
 void Factory::bind(const std::string & name, const uuids::uuid & interfaceUUID,
@@ -688,8 +1272,10 @@ void Factory::bind(const uuids::uuid & interfaceUUID,
                    const std::function<SRef<IComponentIntrospect>(void)> & factoryFunc,
                    const FactoryBindInfos & bindInfos)
 {
-    bind(interfaceUUID, bindInfos);
-    m_context->factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    m_context->update([&interfaceUUID, &bindInfos, &factoryFunc](FactoryBindings & bindings) {
+        insertBind(bindings, interfaceUUID, bindInfos);
+        bindings.factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    });
 }
 
 void Factory::bind(const uuids::uuid & interfaceUUID, const uuids::uuid & instanceUUID,
@@ -704,8 +1290,10 @@ void Factory::bind(const std::string & name, const uuids::uuid & interfaceUUID,
                    const std::function<SRef<IComponentIntrospect>(void)> & factoryFunc,
                    const FactoryBindInfos & bindInfos)
 {
-    bind(name, interfaceUUID, bindInfos);
-    m_context->factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    m_context->update([&name, &interfaceUUID, &bindInfos, &factoryFunc](FactoryBindings & bindings) {
+        insertBind(bindings, name, interfaceUUID, bindInfos);
+        bindings.factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    });
 }
 
 void Factory::bind(const std::string & name, const uuids::uuid & interfaceUUID, const uuids::uuid & instanceUUID,
@@ -720,8 +1308,10 @@ void Factory::bind(const uuids::uuid & targetComponentUUID, const uuids::uuid &
                    const std::function<SRef<IComponentIntrospect>(void)> & factoryFunc,
                    const FactoryBindInfos & bindInfos)
 {
-    bind(targetComponentUUID, interfaceUUID, bindInfos);
-    m_context->factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    m_context->update([&targetComponentUUID, &interfaceUUID, &bindInfos, &factoryFunc](FactoryBindings & bindings) {
+        insertBind(bindings, targetComponentUUID, interfaceUUID, bindInfos);
+        bindings.factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    });
 }
 
 void Factory::bind(const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID,
@@ -736,8 +1326,10 @@ void Factory::bind(const uuids::uuid & targetComponentUUID, const std::string &
                    const std::function<SRef<IComponentIntrospect>(void)> & factoryFunc,
                    const FactoryBindInfos & bindInfos)
 {
-    bind(targetComponentUUID, name, interfaceUUID, bindInfos);
-    m_context->factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    m_context->update([&targetComponentUUID, &name, &interfaceUUID, &bindInfos, &factoryFunc](FactoryBindings & bindings) {
+        insertBind(bindings, targetComponentUUID, name, interfaceUUID, bindInfos);
+        bindings.factoryMethods[bindInfos.componentUUID] = factoryFunc;
+    });
 }
 
 void Factory::bind(const uuids::uuid & targetComponentUUID, const std::string & name, const uuids::uuid & interfaceUUID,
@@ -752,10 +1344,9 @@ void Factory::bind(const uuids::uuid & targetComponentUUID, const std::string &
 void Factory::bind(const uuids::uuid & targetComponentUUID, const uuids::uuid & interfaceUUID,
                    const FactoryBindInfos & bindInfos)
 {
-    if (mapContains(m_context->specificBindings,targetComponentUUID)) {
-        // bind already exists : error ???
-    }
-    m_context->specificBindings[targetComponentUUID][interfaceUUID] = bindInfos;
+    m_context->update([&targetComponentUUID, &interfaceUUID, &bindInfos](FactoryBindings & bindings) {
+        insertBind(bindings, targetComponentUUID, interfaceUUID, bindInfos);
+    });
 }
 
 
@@ -769,10 +1360,9 @@ void Factory::bind(const uuids::uuid & targetComponentUUID, const uuids::uuid &
 void Factory::bind(const uuids::uuid & targetComponentUUID, const std::string & name,
                    const uuids::uuid & interfaceUUID, const FactoryBindInfos & bindInfos)
 {
-    if (mapContains(m_context->specificNamedBindings,targetComponentUUID)) {
-        // bind already exists : error ???
-    }
-    m_context->specificNamedBindings[targetComponentUUID][ make_pair(interfaceUUID,name)] = bindInfos;
+    m_context->update([&targetComponentUUID, &name, &interfaceUUID, &bindInfos](FactoryBindings & bindings) {
+        insertBind(bindings, targetComponentUUID, name, interfaceUUID, bindInfos);
+    });
 }
 
 void Factory::bind(const uuids::uuid & targetComponentUUID, const std::string & name,
@@ -783,27 +1373,32 @@ void Factory::bind(const uuids::uuid & targetComponentUUID, const std::string &
     bind(targetComponentUUID, name, interfaceUUID, FactoryBindInfos{instanceUUID, scope, bindingRangeMask, ""});
 }
 
-FactoryBindInfos Factory::resolveBind(const uuids::uuid & interfaceUUID, std::deque<BindContext> contextLevels)
+Factory::BindResult Factory::tryResolveBind(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings, const BindContext * context,
+                                            bool describeError)
 {
     // search for the closest specific declaration of binding for interfaceUUID : the first context is the last one, the latter is the first specific context created in the tree
     // WARNING : each bindingrange in the loop is replaced with the parent bindingrange : should it be the case ? may be not !
-    for (auto [contextType,contextValue] : contextLevels) {
-        if (contextType == ContextType::Component) {
-            auto componentUUID = contextValue.componentUUID;
-            if (mapContains(m_context->specificBindings, componentUUID)) {
-                if (mapContains(m_context->specificBindings[componentUUID], interfaceUUID)) {
-                    FactoryBindInfos bindInfos = m_context->specificBindings[componentUUID][interfaceUUID];
-                    return bindInfos;
-                }
+    for (const BindContext * level = context; level != nullptr; level = level->parent) {
+        if (level->type == ContextType::Component) {
+            const FactoryBindInfos & contextValue = level->bindInfos;
+            const uuids::uuid & componentUUID = contextValue.componentUUID;
+            const FactoryBindInfos * specificBind = bindings.findSpecificBind(componentUUID, interfaceUUID);
+            if (specificBind != nullptr) {
+                return BindResult(specificBind, "", XPCFErrorCode::_SUCCESS);
             }
             if (contextValue.bindingRangeMask == BindingRange::Explicit) {
                 // if the interface exists in core bindings, return the component
-                if (mapContains (m_coreBindings, interfaceUUID)) {
-                    return m_coreBindings.at(interfaceUUID);
+                auto coreIt = m_coreBindings.find(interfaceUUID);
+                if (coreIt != m_coreBindings.end()) {
+                    return BindResult(&coreIt->second, "", XPCFErrorCode::_SUCCESS);
                 }
                 // when current context binding range is explicit only, do not search forward when explicit bind isn't found
-                throw InjectableNotFoundException("No explicit binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID)
-                                                  + " to inject to " +  uuids::to_string(componentUUID));
+                if (!describeError) {
+                    return BindResult(nullptr, "", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND);
+                }
+                return BindResult(nullptr, "Factory::resolveBind", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND,
+                                  "No explicit binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID)
+                                  + " to inject to " +  uuids::to_string(componentUUID));
             }
             if (!(contextValue.bindingRangeMask & BindingRange::WithParents)) {
                 break;
@@ -811,47 +1406,54 @@ FactoryBindInfos Factory::resolveBind(const uuids::uuid & interfaceUUID, std::de
         }
         //TODO : handle named contexts
     }
+    uint8_t rootRangeMask = (context != nullptr) ? context->root().bindInfos.bindingRangeMask : 0;
     // no specific binding found for this interface in contexts : search for a default binding
-    if (contextLevels.empty() ||
-            contextLevels.back().second.bindingRangeMask & (BindingRange::Default |BindingRange::All)) {
-        if (mapContains(m_context->defaultBindings, interfaceUUID)) {
-            FactoryBindInfos bindInfos = m_context->defaultBindings.at(interfaceUUID);
-            return bindInfos;
+    if (context == nullptr || rootRangeMask & (BindingRange::Default |BindingRange::All)) {
+        const FactoryBindInfos * defaultBind = bindings.findDefaultBind(interfaceUUID);
+        if (defaultBind != nullptr) {
+            return BindResult(defaultBind, "", XPCFErrorCode::_SUCCESS);
         }
     }
     // no default binding found for this interface : search for an autobinding
-    if (contextLevels.empty() ||
-            contextLevels.back().second.bindingRangeMask & BindingRange::All) {
-        if (mapContains(m_context->autoBindings,interfaceUUID)) {
-            return m_context->autoBindings.at(interfaceUUID);
+    if (context == nullptr || rootRangeMask & BindingRange::All) {
+        const FactoryBindInfos * autoBind = bindings.findAutoBind(interfaceUUID);
+        if (autoBind != nullptr) {
+            return BindResult(autoBind, "", XPCFErrorCode::_SUCCESS);
         }
     }
     // no binding found, is it a core binding ?
-    if (mapContains (m_coreBindings, interfaceUUID)) {
-        return m_coreBindings.at(interfaceUUID);
+    auto bindIt = m_coreBindings.find(interfaceUUID);
+    if (bindIt != m_coreBindings.end()) {
+        return BindResult(&bindIt->second, "", XPCFErrorCode::_SUCCESS);
+    }
+    if (!describeError) {
+        return BindResult(nullptr, "", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND);
     }
-    throw InjectableNotFoundException("No [auto|default|named] binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID));
+    return BindResult(nullptr, "Factory::resolveBind", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND,
+                      "No [auto|default|named] binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID));
 }
 
-FactoryBindInfos Factory::resolveBind(const uuids::uuid & interfaceUUID, const std::string & name, std::deque<BindContext> contextLevels)
+Factory::BindResult Factory::tryResolveBind(const uuids::uuid & interfaceUUID, const std::string & name, const FactoryBindings & bindings,
+                                            const BindContext * context, bool describeError)
 {
-    pair<uuids::uuid, string> key = make_pair(interfaceUUID, name);
-
     // search for the closest specific declaration of binding for interfaceUUID : the first context is the last one, the latter is the first specific context created in the tree
     // WARNING : each bindingrange in the loop is replaced with the parent bindingrange : should it be the case ? may be not !
-    for (auto [contextType,contextValue] : contextLevels) {
-        if (contextType == ContextType::Component) {
-            auto componentUUID = contextValue.componentUUID;
-            if (mapContains(m_context->specificNamedBindings, componentUUID)) {
-                if (mapContains(m_context->specificNamedBindings[componentUUID], key)) {
-                    FactoryBindInfos bindInfos = m_context->specificNamedBindings[componentUUID][key];
-                    return bindInfos;
-                }
+    for (const BindContext * level = context; level != nullptr; level = level->parent) {
+        if (level->type == ContextType::Component) {
+            const FactoryBindInfos & contextValue = level->bindInfos;
+            const uuids::uuid & componentUUID = contextValue.componentUUID;
+            const FactoryBindInfos * specificBind = bindings.findSpecificNamedBind(componentUUID, interfaceUUID, name);
+            if (specificBind != nullptr) {
+                return BindResult(specificBind, "", XPCFErrorCode::_SUCCESS);
             }
             if (contextValue.bindingRangeMask == BindingRange::Explicit) {
                 // when current context binding range is explicit only, do not search forward when explicit bind isn't found
-                throw InjectableNotFoundException("No explicit binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID) + " named " + name
-                                                  + " to inject to " +  uuids::to_string(componentUUID));
+                if (!describeError) {
+                    return BindResult(nullptr, "", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND);
+                }
+                return BindResult(nullptr, "Factory::resolveBind", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND,
+                                  "No explicit binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID) + " named " + name
+                                  + " to inject to " +  uuids::to_string(componentUUID));
             }
             if (!(contextValue.bindingRangeMask & BindingRange::WithParents)) {
                 break;
@@ -859,97 +1461,270 @@ FactoryBindInfos Factory::resolveBind(const uuids::uuid & interfaceUUID, const s
         }
         //TODO : handle named contexts
     }
+    uint8_t rootRangeMask = (context != nullptr) ? context->root().bindInfos.bindingRangeMask : 0;
     // no specific named binding found for this interface in contexts : search for a default named binding
-    if (contextLevels.empty() ||
-            contextLevels.back().second.bindingRangeMask & (BindingRange::Named |BindingRange::Default|BindingRange::All)) {
-        if (mapContains(m_context->namedBindings,key)) {
-            FactoryBindInfos bindInfos = m_context->namedBindings.at(key);
-            return bindInfos;
+    if (context == nullptr || rootRangeMask & (BindingRange::Named |BindingRange::Default|BindingRange::All)) {
+        const FactoryBindInfos * namedBind = bindings.findNamedBind(interfaceUUID, name);
+        if (namedBind != nullptr) {
+            return BindResult(namedBind, "", XPCFErrorCode::_SUCCESS);
         }
     }
-    if (!contextLevels.empty() &&
-            !(contextLevels.back().second.bindingRangeMask & (BindingRange::Default|BindingRange::All))) {
-        throw InjectableNotFoundException("No default named binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID) + " named " + name);
+    if (context != nullptr && !(rootRangeMask & (BindingRange::Default|BindingRange::All))) {
+        if (!describeError) {
+            return BindResult(nullptr, "", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND);
+        }
+        return BindResult(nullptr, "Factory::resolveBind", XPCFErrorCode::_ERROR_INJECTABLE_NOBIND,
+                          "No default named binding found to resolve component from interface UUID = " + uuids::to_string(interfaceUUID) + " named " + name);
     }
-    return resolveBind(interfaceUUID, contextLevels);
+    return tryResolveBind(interfaceUUID, bindings, context, describeError);
+}
+
+const FactoryBindInfos & Factory::resolveBind(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings, const BindContext * context)
+{
+    BindResult bind = tryResolveBind(interfaceUUID, bindings, context, true);
+    if (bind.hasError()) {
+        throw InjectableNotFoundException(bind.errMessage());
+    }
+    return *bind.getValue();
+}
+
+const FactoryBindInfos & Factory::resolveBind(const uuids::uuid & interfaceUUID, const std::string & name, const FactoryBindings & bindings,
+                                              const BindContext * context)
+{
+    BindResult bind = tryResolveBind(interfaceUUID, name, bindings, context, true);
+    if (bind.hasError()) {
+        throw InjectableNotFoundException(bind.errMessage());
+    }
+    return *bind.getValue();
 }
 
 uuids::uuid Factory::getComponentUUID(const uuids::uuid & interfaceUUID)
 {
-    FactoryBindInfos bindInfos = resolveBind(interfaceUUID, {});
-    return bindInfos.componentUUID;
+    return resolveBind(interfaceUUID, *m_context->bindings(), nullptr).componentUUID;
 }
 
 uuids::uuid Factory::getComponentUUID(const uuids::uuid & interfaceUUID, const std::string & name)
 {
-    FactoryBindInfos bindInfos = resolveBind(interfaceUUID, name, {});
-    return bindInfos.componentUUID;
+    return resolveBind(interfaceUUID, name, *m_context->bindings(), nullptr).componentUUID;
 }
 
-void Factory::inject(SRef<IInjectable> component, std::deque<BindContext> contextLevels)
+void Factory::inject(SRef<IInjectable> component)
 {
-#ifdef XPCF_WITH_LOGS
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Factory::inject";
-#endif
+    SRef<const FactoryBindings> bindings = m_context->bindings();
+    inject(component, *bindings, nullptr, nullptr);
+}
 
+void Factory::inject(SRef<IInjectable> component, const FactoryBindings & bindings, const BindContext * context, ResolutionPlan * plan)
+{
+    XPCF_LOG(info) << "Factory::inject";
+
+    if (m_parallelInjection && component->getInjectables().size() > 1) {
+        injectConcurrently(component, bindings, context, plan);
+        return;
+    }
     for (auto injectable : component->getInjectables()) {
-        try {
-            if (!injectable->isMulti()) {
-                SRef<IComponentIntrospect> injectableRef = resolve(injectable, contextLevels);
-                injectable->inject(injectableRef);
-            }
-            else {
-                SRef<IEnumerable<SRef<IComponentIntrospect>>> injectableRef = resolveAll(injectable, contextLevels);
-                injectable->inject(injectableRef);
-            }
+        InjectablePlan * injectablePlan = nullptr;
+        if (plan != nullptr) {
+            plan->injectables.emplace_back(injectable->getUuid(), injectable->getName(), injectable->isMulti(), injectable->isLazy());
+            injectablePlan = &plan->injectables.back();
+        }
+        inject(*component, injectable, bindings, context, injectablePlan);
+    }
+    component->onInjected();
+}
+
+void Factory::injectConcurrently(SRef<IInjectable> component, const FactoryBindings & bindings, const BindContext * context,
+                                 ResolutionPlan * plan)
+{
+    std::vector<SPtr<Injector>> injectables;
+    for (auto injectable : component->getInjectables()) {
+        injectables.push_back(injectable);
+        if (plan != nullptr) {
+            plan->injectables.emplace_back(injectable->getUuid(), injectable->getName(), injectable->isMulti(), injectable->isLazy());
+        }
+    }
+    // each injectable subtree is built on its own task : the context chain and the plan entries outlive the tasks
+    TaskGroup group;
+    for (std::size_t i = 0; i < injectables.size(); i++) {
+        InjectablePlan * injectablePlan = (plan != nullptr) ? &plan->injectables[i] : nullptr;
+        group.run([this, &component, &injectables, &bindings, context, injectablePlan, i]() {
+            inject(*component, injectables[i], bindings, context, injectablePlan);
+        });
+    }
+    group.wait();
+    component->onInjected();
+}
+
+bool Factory::hasBind(SPtr<Injector> injectable, const FactoryBindings & bindings, const BindContext * context)
+{
+    if (injectable->isMulti() && bindings.findMultiBinds(injectable->getUuid()) != nullptr) {
+        return true;
+    }
+    if (injectable->isNamed()) {
+        return !tryResolveBind(injectable->getUuid(), injectable->getName(), bindings, context).hasError();
+    }
+    return !tryResolveBind(injectable->getUuid(), bindings, context).hasError();
+}
+
+void Factory::inject(IInjectable & component, SPtr<Injector> injectable, const FactoryBindings & bindings, const BindContext * context,
+                     InjectablePlan * plan)
+{
+    // an optional injectable without bind is left empty : checking the bind first avoids throwing and catching an exception
+    if (injectable->optional() && !hasBind(injectable, bindings, context)) {
+        return;
+    }
+    try {
+        if (injectable->isLazy()) {
+            injectLazy(component, injectable, bindings, context, plan);
         }
-        catch (const InjectableNotFoundException & e) {
-            if (!injectable->optional()) { // only throw when injectable is mandatory
-                throw e;
+        else if (!injectable->isMulti()) {
+            SRef<ResolutionPlan> componentPlan;
+            if (plan != nullptr) {
+                componentPlan = utils::make_shared<ResolutionPlan>();
+                plan->components.push_back(componentPlan);
             }
+            SRef<IComponentIntrospect> injectableRef = resolve(injectable, bindings, context, componentPlan.get());
+            injectable->inject(component, injectableRef);
+        }
+        else {
+            SRef<IEnumerable<SRef<IComponentIntrospect>>> injectableRef = resolveAll(injectable->getUuid(), bindings, context, plan);
+            injectable->inject(component, injectableRef);
         }
-        catch (const Exception& e) {
-            throw ConfigurationException(e.what());
+        if (plan != nullptr) {
+            plan->resolved = true;
         }
     }
-    component->onInjected();
+    catch (const InjectableNotFoundException & e) {
+        if (!injectable->optional()) { // only throw when injectable is mandatory
+            throw e;
+        }
+        if (plan != nullptr) {
+            plan->components.clear();
+        }
+    }
+    catch (const Exception& e) {
+        throw ConfigurationException(e.what());
+    }
+}
+
+void Factory::injectLazy(IInjectable & component, SPtr<Injector> injectable, const FactoryBindings & bindings, const BindContext * context,
+                         InjectablePlan * plan)
+{
+    // the bind is checked upon injection : a missing mandatory bind fails the injection as for any injectable
+    if (injectable->isNamed()) {
+        resolveBind(injectable->getUuid(), injectable->getName(), bindings, context);
+    }
+    else {
+        resolveBind(injectable->getUuid(), bindings, context);
+    }
+    SRef<LazyResolution> lazy = utils::make_shared<LazyResolution>();
+    lazy->bindings = bindings.shared_from_this();
+    for (const BindContext * level = context; level != nullptr; level = level->parent) {
+        lazy->contexts.insert(lazy->contexts.begin(), std::make_pair(level->type, level->bindInfos));
+    }
+    lazy->interfaceUUID = injectable->getUuid();
+    lazy->name = injectable->isNamed() ? injectable->getName() : "";
+    if (plan != nullptr) {
+        plan->lazyResolution = lazy;
+    }
+    injectable->inject(component, lazyResolver(lazy));
+}
+
+LazyResolver Factory::lazyResolver(const SRef<const LazyResolution> & lazy)
+{
+    // the resolver doesn't keep the factory alive : it owns the factory for the duration of the resolution
+    utils::weak_ptr<IComponentIntrospect> factory = selfReference();
+    return [this, factory, lazy]() -> SRef<IComponentIntrospect> {
+        SRef<IComponentIntrospect> factoryRef = factory.lock();
+        if (!factoryRef) {
+            throw ConfigurationException("Lazy injectable resolution failed : the factory that injected it no longer exists");
+        }
+        return resolve(*lazy);
+    };
+}
+
+SRef<IComponentIntrospect> Factory::resolve(const LazyResolution & lazy)
+{
+    SRef<ResolutionPlan> plan = utils::atomic_load(&lazy.plan);
+    if (plan) {
+        SRef<IComponentIntrospect> componentRef = replay(*plan);
+        if (componentRef) {
+            return componentRef;
+        }
+    }
+    // rebuild the context chain of the injection
+    std::vector<BindContext> contexts;
+    contexts.reserve(lazy.contexts.size());
+    const BindContext * context = nullptr;
+    for (auto & level : lazy.contexts) {
+        contexts.push_back(BindContext{level.first, level.second, context});
+        context = &contexts.back();
+    }
+    plan = utils::make_shared<ResolutionPlan>();
+    SRef<IComponentIntrospect> componentRef;
+    if (lazy.name.empty()) {
+        componentRef = resolve(lazy.interfaceUUID, *lazy.bindings, context, plan.get());
+    }
+    else {
+        componentRef = resolve(lazy.interfaceUUID, lazy.name, *lazy.bindings, context, plan.get());
+    }
+    utils::atomic_store(&lazy.plan, plan);
+    return componentRef;
 }
 
-SRef<IComponentIntrospect> Factory::resolveComponent(const FactoryBindInfos & bindInfos, std::deque<BindContext> contextLevels)
+void Factory::configure(SRef<IComponentIntrospect> componentRef, const FactoryBindInfos & bindInfos, const fs::path & configFilePath)
 {
-    try 
+    if (configFilePath.empty() || !componentRef->implements<IConfigurable>()) {
+        return;
+    }
+    SRef<IConfigurable> iconf = componentRef->bindTo<IConfigurable>();
+    XPCFErrorCode confErrCode;
+    if (bindInfos.properties.empty()) {
+        confErrCode = iconf->configure(configFilePath.string().c_str());
+    }
+    else {
+        confErrCode = iconf->configure(configFilePath.string().c_str(), bindInfos.properties.c_str());
+    }
+    if (confErrCode != XPCFErrorCode::_SUCCESS) {
+        throw ConfigurationException("Configuration failed for component uuid=" + uuids::to_string(bindInfos.componentUUID), confErrCode);
+    }
+}
+
+SRef<IComponentIntrospect> Factory::resolveComponent(const FactoryBindInfos & bindInfos, const FactoryBindings & bindings,
+                                                     const BindContext & context, ResolutionPlan * plan)
+{
+    try
     {
         uuids::uuid componentUUID = bindInfos.componentUUID;
         std::function<SRef<IComponentIntrospect>(void)> createComponent = [componentUUID, this]()-> SRef<IComponentIntrospect> {
             return resolveFromModule(componentUUID);
         };
 
-        if (mapContains(m_context->factoryMethods, componentUUID)) {
-            createComponent =  m_context->factoryMethods[componentUUID];
+        const std::function<SRef<IComponentIntrospect>(void)> * factoryMethod = bindings.findFactoryMethod(componentUUID);
+        if (factoryMethod != nullptr) {
+            createComponent = *factoryMethod;
         }
         if (bindInfos.bindingRangeMask == BindingRange_Core) {
-            createComponent =  m_coreFactoryMethods[componentUUID];
-        }
-    #ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Factory::resolveComponent component uuid="<<uuids::to_string(componentUUID);
-    #endif
-        SRef<IComponentIntrospect> componentRef = createComponent();
-        inject(componentRef->bindTo<IInjectable>(), contextLevels);
-        if (componentRef->implements<IConfigurable>()) {
-            fs::path configFilePath = m_propertyManager->getConfigPath(componentUUID);
-            if (! configFilePath.empty()) {
-                SRef<IConfigurable> iconf = componentRef->bindTo<IConfigurable>();
-                XPCFErrorCode confErrCode;
-                if (bindInfos.properties.empty()) {
-                    confErrCode = iconf->configure(configFilePath.string().c_str());
-                }
-                else {
-                    confErrCode = iconf->configure(configFilePath.string().c_str(), bindInfos.properties.c_str());
-                }
-                if (confErrCode != XPCFErrorCode::_SUCCESS) {
-                    throw ConfigurationException("Configuration failed for component uuid=" + uuids::to_string(componentUUID), confErrCode);
+            createComponent = m_coreFactoryMethods.at(componentUUID);
+        }
+        XPCF_LOG(info) << "Factory::resolveComponent component uuid="<<uuids::to_string(componentUUID);
+        SRef<FootprintRecorder> recorder = footprintRecorder();
+        fs::path configFilePath;
+        SRef<IComponentIntrospect> componentRef = constructComponent(recorder.get(), componentUUID, createComponent,
+            [&](const SRef<IComponentIntrospect> & component) {
+                inject(component->bindTo<IInjectable>(), bindings, &context, plan);
+                return true;
+            },
+            [&](const SRef<IComponentIntrospect> & component) {
+                if (component->implements<IConfigurable>()) {
+                    configFilePath = m_propertyManager->getConfigPath(componentUUID);
+                    configure(component, bindInfos, configFilePath);
                 }
-            }
+            });
+        if (plan != nullptr) {
+            plan->createComponent = createComponent;
+            plan->configFilePath = configFilePath;
+            plan->complete = true;
         }
         return componentRef;
     }
@@ -958,92 +1733,535 @@ SRef<IComponentIntrospect> Factory::resolveComponent(const FactoryBindInfos & bi
     }
 }
 
-SRef<IComponentIntrospect> Factory::resolve(const uuids::uuid & interfaceUUID, std::deque<BindContext> contextLevels)
+SRef<SingletonInstance> Factory::singletonInstance(const FactoryBindInfos & bindInfos, const std::string & name)
 {
-    try
+    if (m_parent != nullptr && bindInfos.bindingRangeMask != BindingRange_Core) {
+        return m_parent->singletonInstance(bindInfos, name);
+    }
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    SRef<SingletonInstance> * instance = nullptr;
+    if (!name.empty()) {
+        instance = &m_namedSingletonInstances[make_pair(bindInfos.componentUUID, name)];
+    }
+    else if (bindInfos.bindingRangeMask == BindingRange_Core) {
+        instance = &m_coreInstances[bindInfos.componentUUID];
+    }
+    else {
+        instance = &m_singletonInstances[bindInfos.componentUUID];
+    }
+    if (!*instance) {
+        *instance = utils::make_shared<SingletonInstance>();
+    }
+    return *instance;
+}
+
+SRef<SingletonInstance> Factory::scopedInstance(const FactoryBindInfos & bindInfos, const std::string & name)
+{
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    SRef<SingletonInstance> & instance = m_scopedInstances[make_pair(bindInfos.componentUUID, name)];
+    if (!instance) {
+        instance = utils::make_shared<SingletonInstance>();
+    }
+    return instance;
+}
+
+SRef<PerThreadStorage> PerThreadRegistry::add()
+{
+    SRef<PerThreadStorage> storage = utils::make_shared<PerThreadStorage>();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_storages.push_back(storage);
+    return storage;
+}
+
+void PerThreadRegistry::remove(const PerThreadStorage * storage)
+{
+    // the instances are released outside the lock
+    SRef<PerThreadStorage> removed;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_storages.begin(), m_storages.end(), [storage](const SRef<PerThreadStorage> & s) { return s.get() == storage; });
+    if (it != m_storages.end()) {
+        removed = std::move(*it);
+        *it = std::move(m_storages.back());
+        m_storages.pop_back();
+    }
+}
+
+void PerThreadRegistry::clear()
+{
+    std::vector<SRef<PerThreadStorage>> storages;
     {
-        FactoryBindInfos bindInfos = resolveBind(interfaceUUID, contextLevels);
-    #ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Factory::resolve interface uuid="<<uuids::to_string(interfaceUUID);
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<log(bindInfos).str();
-    #endif
-        contextLevels.push_front({ContextType::Component, bindInfos});
-        if (bindInfos.scope == BindingScope::Singleton) {
-            if (bindInfos.bindingRangeMask != BindingRange_Core) {
-                if (! mapContains(m_singletonInstances, bindInfos.componentUUID)) {
-                    SRef<IComponentIntrospect> componentRef = resolveComponent(bindInfos, contextLevels);
-                    m_singletonInstances[bindInfos.componentUUID] = componentRef;
-                }
-                return m_singletonInstances.at(bindInfos.componentUUID);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        storages.swap(m_storages);
+    }
+}
+
+namespace {
+// Per thread storages of the current thread, keyed upon their registry.
+// The thread only holds weak references : the storages belong to the registries of the factories.
+// The storages of the thread are removed from their registries upon the thread exit.
+struct ThreadStorages {
+    struct Entry {
+        utils::weak_ptr<PerThreadRegistry> registry;
+        utils::weak_ptr<PerThreadStorage> storage;
+    };
+
+    ~ThreadStorages() {
+        for (auto & [registryAddress, entry] : entries) {
+            SRef<PerThreadRegistry> registry = entry.registry.lock();
+            SRef<PerThreadStorage> storage = entry.storage.lock();
+            if (registry && storage) {
+                registry->remove(storage.get());
+            }
+        }
+    }
+
+    SRef<PerThreadStorage> find(const SRef<PerThreadRegistry> & registry);
+
+    std::map<const PerThreadRegistry *, Entry> entries;
+};
+
+SRef<PerThreadStorage> ThreadStorages::find(const SRef<PerThreadRegistry> & registry)
+{
+    auto it = entries.find(registry.get());
+    if (it != entries.end()) {
+        // the entry can belong to a destroyed registry whose address was reused
+        bool sameRegistry = !it->second.registry.owner_before(registry) && !registry.owner_before(it->second.registry);
+        SRef<PerThreadStorage> storage = sameRegistry ? it->second.storage.lock() : SRef<PerThreadStorage>();
+        if (storage) {
+            return storage;
+        }
+    }
+    else {
+        // a storage is added once per factory and per thread : drop the entries of the destroyed factories
+        for (auto entryIt = entries.begin(); entryIt != entries.end();) {
+            if (entryIt->second.registry.expired()) {
+                entryIt = entries.erase(entryIt);
             }
             else {
-                if (! mapContains(m_coreInstances, bindInfos.componentUUID)) {
-                    SRef<IComponentIntrospect> componentRef = resolveComponent(bindInfos, contextLevels);
-                    m_coreInstances[bindInfos.componentUUID] = componentRef;
-                }
-                return m_coreInstances.at(bindInfos.componentUUID);
+                ++entryIt;
             }
         }
-        SRef<IComponentIntrospect> componentRef = resolveComponent(bindInfos, contextLevels);
-        return resolveComponent(bindInfos, contextLevels);
     }
-    catch ( const bcom::xpcf::Exception& e) {
-        throw ConfigurationException(e.what());
+    // new thread, or the registry was cleared
+    SRef<PerThreadStorage> storage = registry->add();
+    entries[registry.get()] = Entry{registry, storage};
+    return storage;
+}
+
+thread_local ThreadStorages threadStorages;
+}
+
+template <typename F> SRef<IComponentIntrospect> Factory::perThreadInstance(const FactoryBindInfos & bindInfos, const std::string & name,
+                                                                           F createInstance)
+{
+    SRef<PerThreadStorage> storage = threadStorages.find(m_perThreadRegistry);
+    auto it = storage->instances.find(std::tie(bindInfos.componentUUID, name));
+    if (it != storage->instances.end()) {
+        return it->second;
+    }
+    // the creation can resolve other per thread instances of the thread : the storage is searched again afterwards
+    SRef<IComponentIntrospect> componentRef = createInstance();
+    if (componentRef) {
+        storage->instances.emplace(std::make_tuple(bindInfos.componentUUID, name), componentRef);
+    }
+    return componentRef;
+}
+
+ComponentPool::~ComponentPool()
+{
+    for (ComponentBase * component : m_instances) {
+        component->unload();
+    }
+}
+
+ComponentBase * ComponentPool::acquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_instances.empty()) {
+        return nullptr;
+    }
+    ComponentBase * component = m_instances.back();
+    m_instances.pop_back();
+    return component;
+}
+
+std::function<bool(ComponentBase *)> ComponentPool::recycler()
+{
+    // instances released after the pool destruction are unloaded
+    utils::weak_ptr<ComponentPool> pool = shared_from_this();
+    return [pool](ComponentBase * component) -> bool {
+        SRef<ComponentPool> poolRef = pool.lock();
+        return poolRef ? poolRef->recycle(component) : false;
+    };
+}
+
+bool ComponentPool::recycle(ComponentBase * component)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_instances.size() >= m_poolSize) {
+        return false;
+    }
+    m_instances.push_back(component);
+    return true;
+}
+
+SRef<IComponentIntrospect> Factory::acquire(ComponentPool & pool)
+{
+    ComponentBase * component = pool.acquire();
+    if (component == nullptr) {
+        return SRef<IComponentIntrospect>();
     }
+    return component->introspect();
 }
 
-SRef<IComponentIntrospect> Factory::resolve(const uuids::uuid & interfaceUUID, const string & name, std::deque<BindContext> contextLevels )
+void Factory::track(ComponentPool & pool, SRef<IComponentIntrospect> componentRef)
 {
-    FactoryBindInfos bindInfos = resolveBind(interfaceUUID, name, contextLevels);
+    // only ComponentBase derived components can be recycled : other components are handled as transient ones
+    ComponentBase * component = dynamic_cast<ComponentBase *>(componentRef.get());
+    if (component != nullptr) {
+        component->setRecycler(pool.recycler());
+    }
+}
 
-    contextLevels.push_front({ContextType::Component, bindInfos});
+SRef<IComponentIntrospect> Factory::resolveInstance(const FactoryBindInfos & bindInfos, const std::string & name,
+                                                    const FactoryBindings & bindings, const BindContext & context,
+                                                    ResolutionPlan * plan)
+{
+    if (plan != nullptr) {
+        plan->bindInfos = bindInfos;
+        plan->name = name;
+    }
     if (bindInfos.scope == BindingScope::Singleton) {
-        pair<uuids::uuid,string> key = make_pair(bindInfos.componentUUID, name);
-        if (! mapContains(m_namedSingletonInstances,key)) {
-            SRef<IComponentIntrospect> componentRef = resolveComponent(bindInfos, contextLevels);
-            m_namedSingletonInstances[key] = componentRef;
+        SRef<SingletonInstance> instance = singletonInstance(bindInfos, name);
+        if (plan != nullptr) {
+            plan->singleton = instance;
+        }
+        return instance->get([&]() { return resolveComponent(bindInfos, bindings, context, plan); });
+    }
+    if (bindInfos.scope == BindingScope::Scoped && m_parent != nullptr) {
+        // the plan is shared with the other scopes : the replay finds the instance of the replaying scope
+        SRef<SingletonInstance> instance = scopedInstance(bindInfos, name);
+        return instance->get([&]() { return resolveComponent(bindInfos, bindings, context, plan); });
+    }
+    if (bindInfos.scope == BindingScope::PerThread) {
+        if (plan != nullptr) {
+            plan->perThread = true;
         }
-        return m_namedSingletonInstances.at(key);
+        return perThreadInstance(bindInfos, name, [&]() { return resolveComponent(bindInfos, bindings, context, plan); });
     }
-    return resolveComponent(bindInfos, contextLevels);
+    if (bindInfos.scope == BindingScope::Pooled && plan != nullptr) {
+        // the pool belongs to the plan : it lives as long as the bindings it was recorded upon
+        plan->pool = utils::make_shared<ComponentPool>(bindInfos.poolSize);
+        SRef<IComponentIntrospect> componentRef = resolveComponent(bindInfos, bindings, context, plan);
+        track(*plan->pool, componentRef);
+        return componentRef;
+    }
+    return resolveComponent(bindInfos, bindings, context, plan);
 }
 
-SRef<IComponentIntrospect> Factory::resolve(const SRef<InjectableMetadata> & injectableInfo, std::deque<BindContext> contextLevels )
+SRef<IComponentIntrospect> Factory::resolve(const uuids::uuid & interfaceUUID, const FactoryBindings & bindings,
+                                            const BindContext * context, ResolutionPlan * plan)
 {
-    if (injectableInfo->isNamed()) {
-        return resolve(injectableInfo->getUuid(), injectableInfo->getName(), contextLevels);
+    try
+    {
+        const FactoryBindInfos & bindInfos = resolveBind(interfaceUUID, bindings, context);
+        XPCF_LOG(info) << "Factory::resolve interface uuid="<<uuids::to_string(interfaceUUID);
+#ifdef XPCF_WITH_LOGS
+        XPCF_LOG(info) << log(bindInfos).str();
+#endif
+        BindContext componentContext{ContextType::Component, bindInfos, context};
+        return resolveInstance(bindInfos, "", bindings, componentContext, plan);
+    }
+    catch ( const bcom::xpcf::Exception& e) {
+        throw ConfigurationException(e.what());
     }
-    return resolve(injectableInfo->getUuid(), contextLevels);
 }
 
-const SRef<IEnumerable<SRef<IComponentIntrospect>>> Factory::resolveAll(const SPtr<InjectableMetadata> & injectableInfo,
-                                                                        std::deque<BindContext> contextLevels)
+SRef<IComponentIntrospect> Factory::resolve(const uuids::uuid & interfaceUUID, const string & name, const FactoryBindings & bindings,
+                                            const BindContext * context, ResolutionPlan * plan)
 {
-    return resolveAll(injectableInfo->getUuid(), contextLevels);
+    const FactoryBindInfos & bindInfos = resolveBind(interfaceUUID, name, bindings, context);
+
+    BindContext componentContext{ContextType::Component, bindInfos, context};
+    return resolveInstance(bindInfos, name, bindings, componentContext, plan);
+}
+
+SRef<IComponentIntrospect> Factory::resolve(const SRef<InjectableMetadata> & injectableInfo, const FactoryBindings & bindings,
+                                            const BindContext * context, ResolutionPlan * plan)
+{
+    if (injectableInfo->isNamed()) {
+        return resolve(injectableInfo->getUuid(), injectableInfo->getName(), bindings, context, plan);
+    }
+    return resolve(injectableInfo->getUuid(), bindings, context, plan);
 }
 
 const SRef<IEnumerable<SRef<IComponentIntrospect>>> Factory::resolveAll(const uuids::uuid & interfaceUUID,
-                                                                        std::deque<BindContext> contextLevels)
+                                                                        const FactoryBindings & bindings,
+                                                                        const BindContext * context,
+                                                                        InjectablePlan * plan)
 {
     SRef<ICollection<SRef<IComponentIntrospect>>> componentSet = utils::make_shared<Collection<SRef<IComponentIntrospect>,std::vector>>();
-    if (!mapContains(m_context->multiBindings,interfaceUUID)) {
+    const std::vector<FactoryBindInfos> * multiBinds = bindings.findMultiBinds(interfaceUUID);
+    if (multiBinds == nullptr) {
         //no explicit multibind : resolve any existing single bind default or explicit
-        componentSet->add(resolve(interfaceUUID, contextLevels));
+        SRef<ResolutionPlan> componentPlan;
+        if (plan != nullptr) {
+            componentPlan = utils::make_shared<ResolutionPlan>();
+            plan->components.push_back(componentPlan);
+        }
+        componentSet->add(resolve(interfaceUUID, bindings, context, componentPlan.get()));
         return componentSet;
     }
 
     //multibind declared !
-    for (auto bindInfos : m_context->multiBindings.at(interfaceUUID)) {
-        contextLevels.push_front({ContextType::Component, bindInfos});
-        if (bindInfos.scope == BindingScope::Singleton) {
-            if (! mapContains(m_singletonInstances, bindInfos.componentUUID)) {
-                SRef<IComponentIntrospect> componentRef = resolveComponent(bindInfos, contextLevels);
-                m_singletonInstances[bindInfos.componentUUID] = componentRef;
+    for (const FactoryBindInfos & bindInfos : *multiBinds) {
+        // each component is resolved in its own context, from the caller context
+        BindContext componentContext{ContextType::Component, bindInfos, context};
+        SRef<ResolutionPlan> componentPlan;
+        if (plan != nullptr) {
+            componentPlan = utils::make_shared<ResolutionPlan>();
+            plan->components.push_back(componentPlan);
+        }
+        componentSet->add(resolveInstance(bindInfos, "", bindings, componentContext, componentPlan.get()));
+    }
+    return componentSet;
+}
+
+SRef<IComponentIntrospect> Factory::resolve(const uuids::uuid & interfaceUUID)
+{
+    return resolveFromPlan(interfaceUUID, "");
+}
+
+SRef<IComponentIntrospect> Factory::resolve(const uuids::uuid & interfaceUUID, const std::string & name)
+{
+    return resolveFromPlan(interfaceUUID, name);
+}
+
+const SRef<IEnumerable<SRef<IComponentIntrospect>>> Factory::resolveAll(const uuids::uuid & interfaceUUID)
+{
+    SRef<const FactoryBindings> bindings = m_context->bindings();
+    SRef<InjectablePlan> plan = findResolutionPlan(interfaceUUID, bindings->revision);
+    if (plan) {
+        SRef<IEnumerable<SRef<IComponentIntrospect>>> componentSet = replay(*plan);
+        if (componentSet) {
+            return componentSet;
+        }
+    }
+    plan = utils::make_shared<InjectablePlan>();
+    plan->interfaceUUID = interfaceUUID;
+    plan->multi = true;
+    SRef<IEnumerable<SRef<IComponentIntrospect>>> componentSet = resolveAll(interfaceUUID, *bindings, nullptr, plan.get());
+    plan->resolved = true;
+    updateResolutionPlans(bindings->revision, [&interfaceUUID, &plan](ResolutionPlanTable & table) {
+        table.multiPlans[interfaceUUID] = plan;
+    });
+    return componentSet;
+}
+
+SRef<ResolutionPlan> Factory::findResolutionPlan(const pair<uuids::uuid,string> & key, uint64_t revision) const
+{
+    SRef<const ResolutionPlanTable> table = utils::atomic_load(&m_root->m_resolutionPlans);
+    if (!table || table->revision != revision) {
+        return SRef<ResolutionPlan>();
+    }
+    auto it = table->plans.find(key);
+    return (it != table->plans.end()) ? it->second : SRef<ResolutionPlan>();
+}
+
+SRef<InjectablePlan> Factory::findResolutionPlan(const uuids::uuid & interfaceUUID, uint64_t revision) const
+{
+    SRef<const ResolutionPlanTable> table = utils::atomic_load(&m_root->m_resolutionPlans);
+    if (!table || table->revision != revision) {
+        return SRef<InjectablePlan>();
+    }
+    auto it = table->multiPlans.find(interfaceUUID);
+    return (it != table->multiPlans.end()) ? it->second : SRef<InjectablePlan>();
+}
+
+void Factory::updateResolutionPlans(uint64_t revision, const std::function<void(ResolutionPlanTable &)> & modifier)
+{
+    std::lock_guard<std::mutex> lock(m_root->m_resolutionPlansMutex);
+    SRef<const ResolutionPlanTable> table = utils::atomic_load(&m_root->m_resolutionPlans);
+    SRef<ResolutionPlanTable> newTable;
+    if (table && table->revision == revision) {
+        newTable = utils::make_shared<ResolutionPlanTable>(*table);
+    }
+    else if (!table || table->revision < revision) {
+        // plans recorded upon older bindings are outdated
+        newTable = utils::make_shared<ResolutionPlanTable>();
+        newTable->revision = revision;
+    }
+    else {
+        // the plan was recorded upon bindings that changed meanwhile : don't publish it
+        return;
+    }
+    modifier(*newTable);
+    utils::atomic_store(&m_root->m_resolutionPlans, SRef<const ResolutionPlanTable>(newTable));
+}
+
+SRef<IComponentIntrospect> Factory::resolveFromPlan(const uuids::uuid & interfaceUUID, const std::string & name)
+{
+    return resolveFromPlan(interfaceUUID, name, m_context->bindings());
+}
+
+SRef<IComponentIntrospect> Factory::resolveFromPlan(const uuids::uuid & interfaceUUID, const std::string & name,
+                                                    const SRef<const FactoryBindings> & bindings)
+{
+    pair<uuids::uuid,string> key = make_pair(interfaceUUID, name);
+    SRef<ResolutionPlan> plan = findResolutionPlan(key, bindings->revision);
+    if (plan) {
+        SRef<IComponentIntrospect> componentRef = replay(*plan);
+        if (componentRef) {
+            return componentRef;
+        }
+        // the plan doesn't match the components anymore (for instance injectables declared upon instance state) : record it again
+    }
+    plan = utils::make_shared<ResolutionPlan>();
+    SRef<IComponentIntrospect> componentRef;
+    if (name.empty()) {
+        componentRef = resolve(interfaceUUID, *bindings, nullptr, plan.get());
+    }
+    else {
+        componentRef = resolve(interfaceUUID, name, *bindings, nullptr, plan.get());
+    }
+    updateResolutionPlans(bindings->revision, [&key, &plan](ResolutionPlanTable & table) {
+        table.plans[key] = plan;
+    });
+    return componentRef;
+}
+
+SRef<IComponentIntrospect> Factory::replay(const ResolutionPlan & plan)
+{
+    if (plan.singleton) {
+        // the instance is created by the first thread replaying or resolving the singleton
+        return plan.singleton->get([this, &plan]() { return replayComponent(plan); });
+    }
+    if (plan.bindInfos.scope == BindingScope::Scoped && m_parent != nullptr) {
+        return scopedInstance(plan.bindInfos, plan.name)->get([this, &plan]() { return replayComponent(plan); });
+    }
+    if (plan.perThread) {
+        return perThreadInstance(plan.bindInfos, plan.name, [this, &plan]() { return replayComponent(plan); });
+    }
+    if (plan.pool) {
+        SRef<IComponentIntrospect> componentRef = acquire(*plan.pool);
+        if (!componentRef) {
+            componentRef = replayComponent(plan);
+            if (componentRef) {
+                track(*plan.pool, componentRef);
+            }
+        }
+        return componentRef;
+    }
+    return replayComponent(plan);
+}
+
+SRef<IComponentIntrospect> Factory::replayComponent(const ResolutionPlan & plan)
+{
+    if (!plan.complete) {
+        return SRef<IComponentIntrospect>();
+    }
+    try
+    {
+        SRef<FootprintRecorder> recorder = footprintRecorder();
+        return constructComponent(recorder.get(), plan.bindInfos.componentUUID, plan.createComponent,
+            [this, &plan](const SRef<IComponentIntrospect> & componentRef) {
+                return replayInjection(componentRef->bindTo<IInjectable>(), plan);
+            },
+            [this, &plan](const SRef<IComponentIntrospect> & componentRef) {
+                configure(componentRef, plan.bindInfos, plan.configFilePath);
+            });
+    }
+    catch (const bcom::xpcf::Exception& e) {
+        throw ConfigurationException(e.what());
+    }
+}
+
+bool Factory::replayInjection(SRef<IInjectable> component, const ResolutionPlan & plan)
+{
+    if (m_parallelInjection && plan.injectables.size() > 1) {
+        return replayInjectionConcurrently(component, plan);
+    }
+    std::size_t index = 0;
+    for (auto injectable : component->getInjectables()) {
+        if (index >= plan.injectables.size()) {
+            return false;
+        }
+        if (!replay(*component, injectable, plan.injectables[index++])) {
+            return false;
+        }
+    }
+    if (index != plan.injectables.size()) {
+        return false;
+    }
+    component->onInjected();
+    return true;
+}
+
+bool Factory::replayInjectionConcurrently(SRef<IInjectable> component, const ResolutionPlan & plan)
+{
+    std::vector<SPtr<Injector>> injectables;
+    for (auto injectable : component->getInjectables()) {
+        injectables.push_back(injectable);
+    }
+    if (injectables.size() != plan.injectables.size()) {
+        return false;
+    }
+    std::atomic<bool> replayed(true);
+    TaskGroup group;
+    for (std::size_t i = 0; i < injectables.size(); i++) {
+        group.run([this, &component, &injectables, &plan, &replayed, i]() {
+            if (!replay(*component, injectables[i], plan.injectables[i])) {
+                replayed = false;
             }
-            componentSet->add(m_singletonInstances.at(bindInfos.componentUUID));
+        });
+    }
+    group.wait();
+    if (!replayed) {
+        return false;
+    }
+    component->onInjected();
+    return true;
+}
+
+bool Factory::replay(IInjectable & component, SPtr<Injector> injectable, const InjectablePlan & plan)
+{
+    if (plan.interfaceUUID != injectable->getUuid() || plan.multi != injectable->isMulti()
+            || plan.lazy != injectable->isLazy() || plan.name != injectable->getName()) {
+        return false;
+    }
+    if (!plan.resolved) {
+        // optional injectable without any bind
+        return true;
+    }
+    if (plan.lazy) {
+        injectable->inject(component, lazyResolver(plan.lazyResolution));
+    }
+    else if (!injectable->isMulti()) {
+        SRef<IComponentIntrospect> injectableRef = replay(*plan.components.front());
+        if (!injectableRef) {
+            return false;
+        }
+        injectable->inject(component, injectableRef);
+    }
+    else {
+        SRef<IEnumerable<SRef<IComponentIntrospect>>> injectableRef = replay(plan);
+        if (!injectableRef) {
+            return false;
+        }
+        injectable->inject(component, injectableRef);
+    }
+    return true;
+}
+
+const SRef<IEnumerable<SRef<IComponentIntrospect>>> Factory::replay(const InjectablePlan & plan)
+{
+    SRef<ICollection<SRef<IComponentIntrospect>>> componentSet = utils::make_shared<Collection<SRef<IComponentIntrospect>,std::vector>>();
+    for (auto & componentPlan : plan.components) {
+        SRef<IComponentIntrospect> componentRef = replay(*componentPlan);
+        if (!componentRef) {
+            return SRef<IEnumerable<SRef<IComponentIntrospect>>>();
         }
-        auto component = resolveComponent(bindInfos, contextLevels);
-        componentSet->add(component);
+        componentSet->add(componentRef);
     }
     return componentSet;
 }
@@ -0,0 +1,149 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief components construction cost recording
+ * @date 2026-10-17
+ */
+
+#include "private/xpcf/FootprintRecorder.h"
+
+namespace org { namespace bcom { namespace xpcf {
+
+namespace {
+// innermost construction measured on the thread
+thread_local FootprintScope * t_currentScope = nullptr;
+}
+
+std::atomic<uint32_t> ComponentFactory::m_footprintScopesCount(0);
+
+void ComponentFactory::recordInstanceSize(std::size_t size)
+{
+    FootprintScope::recordInstanceSize(size);
+}
+
+void FootprintRecorder::record(const ComponentFootprint & footprint)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_footprints.find(footprint.componentUUID);
+    if (it == m_footprints.end()) {
+        m_footprints.emplace(footprint.componentUUID, footprint);
+        return;
+    }
+    ComponentFootprint & total = it->second;
+    if (footprint.instanceSize != 0) {
+        total.instanceSize = footprint.instanceSize;
+    }
+    total.instances += footprint.instances;
+    total.creationBytes += footprint.creationBytes;
+    total.injectionBytes += footprint.injectionBytes;
+    total.configurationBytes += footprint.configurationBytes;
+    total.creationDuration += footprint.creationDuration;
+    total.injectionDuration += footprint.injectionDuration;
+    total.configurationDuration += footprint.configurationDuration;
+}
+
+std::vector<ComponentFootprint> FootprintRecorder::report() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ComponentFootprint> footprints;
+    for (auto & [componentUUID, footprint] : m_footprints) {
+        footprints.push_back(footprint);
+    }
+    return footprints;
+}
+
+FootprintScope::FootprintScope(FootprintRecorder * recorder):m_recorder(recorder)
+{
+    if (m_recorder == nullptr) {
+        return;
+    }
+    m_parent = t_currentScope;
+    t_currentScope = this;
+    ComponentFactory::m_footprintScopesCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+FootprintScope::~FootprintScope()
+{
+    if (m_recorder == nullptr) {
+        return;
+    }
+    t_currentScope = m_parent;
+    ComponentFactory::m_footprintScopesCount.fetch_sub(1, std::memory_order_relaxed);
+    if (m_parent != nullptr) {
+        // the whole construction is subtracted from the phase of the parent running it
+        m_parent->m_nestedBytes += m_nestedBytes + m_footprint.creationBytes + m_footprint.injectionBytes + m_footprint.configurationBytes;
+        m_parent->m_nestedDuration += m_nestedDuration + m_footprint.creationDuration + m_footprint.injectionDuration + m_footprint.configurationDuration;
+    }
+}
+
+void FootprintScope::start()
+{
+    if (m_recorder == nullptr) {
+        return;
+    }
+    m_nestedBytesAtStart = m_nestedBytes;
+    m_nestedDurationAtStart = m_nestedDuration;
+    m_startBytes = m_recorder->allocatedBytes();
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+void FootprintScope::stop(Phase phase)
+{
+    if (m_recorder == nullptr) {
+        return;
+    }
+    std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - m_startTime;
+    uint64_t bytes = m_recorder->allocatedBytes() - m_startBytes;
+    duration -= m_nestedDuration - m_nestedDurationAtStart;
+    bytes -= m_nestedBytes - m_nestedBytesAtStart;
+    switch (phase) {
+    case Phase::Creation :
+        m_footprint.creationBytes += bytes;
+        m_footprint.creationDuration += duration;
+        break;
+    case Phase::Injection :
+        m_footprint.injectionBytes += bytes;
+        m_footprint.injectionDuration += duration;
+        break;
+    case Phase::Configuration :
+        m_footprint.configurationBytes += bytes;
+        m_footprint.configurationDuration += duration;
+        break;
+    default:
+        break;
+    }
+}
+
+void FootprintScope::commit(const uuids::uuid & componentUUID)
+{
+    if (m_recorder == nullptr) {
+        return;
+    }
+    m_footprint.componentUUID = componentUUID;
+    m_footprint.instances = 1;
+    m_recorder->record(m_footprint);
+}
+
+void FootprintScope::recordInstanceSize(std::size_t size)
+{
+    if (t_currentScope != nullptr) {
+        t_currentScope->m_footprint.instanceSize = size;
+    }
+}
+
+}}} //namespace org::bcom::xpcf
@@ -85,53 +85,64 @@ const uuids::uuid & InjectableMetadata::getUuid() const { return m_pimpl->m_serv
 
 class Injector::InjectorImpl {
 public:
-    InjectorImpl(const std::function<void(SRef<IComponentIntrospect>)> & injector);
+    InjectorImpl(Setter setter, std::ptrdiff_t offset):m_setter(setter),m_offset(offset) {}
+    InjectorImpl(MultiSetter setter, std::ptrdiff_t offset):m_multiSetter(setter),m_offset(offset),m_isMulti(true) {}
+    InjectorImpl(LazySetter setter, std::ptrdiff_t offset):m_lazySetter(setter),m_offset(offset),m_isLazy(true) {}
     InjectorImpl(const InjectorImpl & copy ) = default;
-    InjectorImpl(const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector);
-    const std::function<void(SRef<IComponentIntrospect>)> m_injector;
-    const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> m_multiInjector;
-    bool m_isMulti;
+    const Setter m_setter = nullptr;
+    const MultiSetter m_multiSetter = nullptr;
+    const LazySetter m_lazySetter = nullptr;
+    const std::ptrdiff_t m_offset;
+    bool m_isMulti = false;
+    bool m_isLazy = false;
 
 };
 
-Injector::InjectorImpl::InjectorImpl( const std::function<void(SRef<IComponentIntrospect>)> & injector): m_injector(injector),m_isMulti(false)
+Injector::Injector(Setter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, bool optional):
+    InjectableMetadata(serviceUUID,optional), m_pimpl(new InjectorImpl(setter, offset))
 {
 }
 
-Injector::InjectorImpl::InjectorImpl( const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector): m_multiInjector(injector),m_isMulti(true)
+Injector::Injector(Setter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, const char * name, bool optional):
+    InjectableMetadata(serviceUUID,name,optional), m_pimpl(new InjectorImpl(setter, offset))
 {
 }
 
-Injector::Injector( const std::function<void(SRef<IComponentIntrospect>)> & injector, uuids::uuid serviceUUID,  bool optional ):
-    InjectableMetadata(serviceUUID,optional), m_pimpl(new InjectorImpl(injector))
+Injector::Injector(MultiSetter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, bool optional):
+    InjectableMetadata(serviceUUID,optional), m_pimpl(new InjectorImpl(setter, offset))
 {
 }
 
-Injector::Injector( const std::function<void(SRef<IComponentIntrospect>)> & injector, uuids::uuid serviceUUID, const char * name, bool optional ):
-    InjectableMetadata(serviceUUID,name,optional), m_pimpl(new InjectorImpl(injector))
+Injector::Injector(LazySetter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, bool optional):
+    InjectableMetadata(serviceUUID,optional), m_pimpl(new InjectorImpl(setter, offset))
 {
 }
 
-Injector::Injector( const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector, uuids::uuid serviceUUID,  bool optional ):
-    InjectableMetadata(serviceUUID,optional), m_pimpl(new InjectorImpl(injector))
+Injector::Injector(LazySetter setter, std::ptrdiff_t offset, uuids::uuid serviceUUID, const char * name, bool optional):
+    InjectableMetadata(serviceUUID,name,optional), m_pimpl(new InjectorImpl(setter, offset))
 {
 }
 
-Injector::Injector( const std::function<void(SRef<IEnumerable<SRef<IComponentIntrospect>>>)> & injector, uuids::uuid serviceUUID, const char * name, bool optional ):
-    InjectableMetadata(serviceUUID,name,optional), m_pimpl(new InjectorImpl(injector))
+Injector::~Injector() {}
+
+void * Injector::injectable(IInjectable & component) const
 {
+    return reinterpret_cast<char *>(&component) + m_pimpl->m_offset;
 }
 
-Injector::~Injector() {}
+std::ptrdiff_t Injector::offset() const
+{
+    return m_pimpl->m_offset;
+}
 
-void Injector::inject(SRef<IComponentIntrospect> instance)
+void Injector::inject(IInjectable & component, SRef<IComponentIntrospect> instance) const
 {
-    m_pimpl->m_injector(instance);
+    m_pimpl->m_setter(injectable(component), instance);
 }
 
-void Injector::inject(SRef<IEnumerable<SRef<IComponentIntrospect>>> instance)
+void Injector::inject(IInjectable & component, SRef<IEnumerable<SRef<IComponentIntrospect>>> instance) const
 {
-    m_pimpl->m_multiInjector(instance);
+    m_pimpl->m_multiSetter(injectable(component), instance);
 }
 
 bool Injector::isMulti()
@@ -139,4 +150,14 @@ bool Injector::isMulti()
     return m_pimpl->m_isMulti;
 }
 
+void Injector::inject(IInjectable & component, const LazyResolver & resolver) const
+{
+    m_pimpl->m_lazySetter(injectable(component), resolver);
+}
+
+bool Injector::isLazy()
+{
+    return m_pimpl->m_isLazy;
+}
+
 }}} //namespace org::bcom::xpcf
@@ -0,0 +1,107 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief xpcf internal logging facility
+ * @date 2026-10-17
+ */
+
+#include "private/xpcf/Logger.h"
+
+#ifdef XPCF_WITH_LOGS
+#include <boost/core/null_deleter.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/log/sinks/unbounded_fifo_queue.hpp>
+#include <boost/make_shared.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace org { namespace bcom { namespace xpcf { namespace log {
+
+namespace {
+
+// unbounded_fifo_queue is a lock-free queue : feeding the sink never waits for the sink thread
+using AsyncSink = boost::log::sinks::asynchronous_sink<boost::log::sinks::text_ostream_backend, boost::log::sinks::unbounded_fifo_queue>;
+
+class LoggerRegistry {
+public:
+    LoggerRegistry();
+    Logger & getLogger(const char * className);
+    void flush() { m_sink->flush(); }
+
+private:
+    std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<Logger>> m_loggers;
+    boost::shared_ptr<AsyncSink> m_sink;
+};
+
+LoggerRegistry::LoggerRegistry()
+{
+    namespace expr = boost::log::expressions;
+    boost::shared_ptr<boost::log::sinks::text_ostream_backend> backend = boost::make_shared<boost::log::sinks::text_ostream_backend>();
+    backend->add_stream(boost::shared_ptr<std::ostream>(&std::clog, boost::null_deleter()));
+    m_sink = boost::make_shared<AsyncSink>(backend);
+    m_sink->set_formatter(expr::stream << "[" << boost::log::trivial::severity << "] "
+                          << expr::attr<std::string>("ClassName") << " : " << expr::smessage);
+    // the sink is added to the global logging core : it only writes the xpcf records, not those of the host application
+    m_sink->set_filter(expr::has_attr<std::string>("ClassName"));
+    boost::log::core::get()->add_sink(m_sink);
+    // the pending records are written upon exit
+    std::atexit(&log::flush);
+}
+
+Logger & LoggerRegistry::getLogger(const char * className)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<Logger> & logger = m_loggers[className];
+    if (!logger) {
+        logger.reset(new Logger());
+        logger->add_attribute("ClassName", boost::log::attributes::constant<std::string>(className));
+    }
+    return *logger;
+}
+
+LoggerRegistry & registry()
+{
+    // never destroyed : components released during the static objects destruction can still log
+    static LoggerRegistry * loggerRegistry = new LoggerRegistry();
+    return *loggerRegistry;
+}
+
+}
+
+Logger & getLogger(const char * className)
+{
+    return registry().getLogger(className);
+}
+
+void flush()
+{
+    registry().flush();
+}
+
+}}}} //namespace org::bcom::xpcf::log
+
+#endif
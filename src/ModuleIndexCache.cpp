@@ -0,0 +1,356 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief persistent cache of the introspected modules metadata
+ * @date 2026-10-17
+ */
+
+#include "private/xpcf/ModuleIndexCache.h"
+#include "private/xpcf/Logger.h"
+#include "private/xpcf/PathBuilder.h"
+
+#include <array>
+#include <ctime>
+#include <fstream>
+
+namespace org { namespace bcom { namespace xpcf {
+
+XPCF_DEFINE_LOGGER("ModuleIndexCache")
+
+namespace {
+
+// the file starts with the magic number and the format version. Values are written in the host byte order
+constexpr uint64_t cacheMagic = 0x58504346494e4458; // "XPCFINDX"
+constexpr uint32_t cacheVersion = 1;
+// bounds the strings and sequences read, so that a corrupted file is rejected instead of allocating its garbage sizes
+constexpr uint32_t maxRecordSize = 1 << 20;
+
+class CacheWriter {
+public:
+    explicit CacheWriter(std::ostream & out):m_out(out) {}
+    template <typename T> void write(T value) { m_out.write(reinterpret_cast<const char *>(&value), sizeof(T)); }
+    void write(const std::string & str) {
+        write(static_cast<uint32_t>(str.size()));
+        m_out.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+    void write(const uuids::uuid & uuid) {
+#ifdef XPCF_USE_BOOST
+        m_out.write(reinterpret_cast<const char *>(uuid.data), static_cast<std::streamsize>(uuid.size()));
+#else
+        auto bytes = uuid.as_bytes();
+        m_out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+#endif
+    }
+
+private:
+    std::ostream & m_out;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(std::istream & in):m_in(in) {}
+    template <typename T> T read() {
+        T value{};
+        m_in.read(reinterpret_cast<char *>(&value), sizeof(T));
+        return value;
+    }
+    uint32_t readSize() {
+        uint32_t size = read<uint32_t>();
+        if (size > maxRecordSize) {
+            m_in.setstate(std::ios::failbit);
+            return 0;
+        }
+        return size;
+    }
+    std::string readString() {
+        std::string str(readSize(), '\0');
+        m_in.read(&str[0], static_cast<std::streamsize>(str.size()));
+        return str;
+    }
+    uuids::uuid readUUID() {
+        std::array<uint8_t, 16> bytes{};
+        m_in.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return detail::makeUUID(bytes, std::make_index_sequence<16>{});
+    }
+    bool good() const { return m_in.good(); }
+
+private:
+    std::istream & m_in;
+};
+
+}
+
+fs::path ModuleIndexCache::defaultPath()
+{
+    return PathBuilder::getXPCFHomePath() / "modules.cache";
+}
+
+std::string ModuleIndexCache::key(const fs::path & modulePath)
+{
+    return fs::absolute(modulePath).generic_string();
+}
+
+uint64_t ModuleIndexCache::contentHash(const fs::path & modulePath)
+{
+    // 64 bits FNV-1a
+    uint64_t hash = 0xcbf29ce484222325;
+    std::ifstream in(modulePath.string(), std::ios::binary);
+    std::vector<char> buffer(1 << 16);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::streamsize count = in.gcount();
+        for (std::streamsize i = 0; i < count; i++) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 0x100000001b3;
+        }
+    }
+    return hash;
+}
+
+void ModuleIndexCache::load()
+{
+    std::map<std::string, ModuleRecord> modules;
+    std::ifstream in(m_cacheFilePath.string(), std::ios::binary);
+    if (!in) {
+        return;
+    }
+    CacheReader reader(in);
+    if (reader.read<uint64_t>() != cacheMagic || reader.read<uint32_t>() != cacheVersion) {
+        XPCF_LOG(info) << "Ignoring incompatible module index cache " << m_cacheFilePath.generic_string();
+        return;
+    }
+    uint32_t modulesCount = reader.readSize();
+    for (uint32_t i = 0; i < modulesCount && reader.good(); i++) {
+        std::string modulePath = reader.readString();
+        ModuleRecord & module = modules[modulePath];
+        module.size = reader.read<uint64_t>();
+        module.lastWriteTime = reader.read<int64_t>();
+        module.contentHash = reader.read<uint64_t>();
+        module.metadata = {reader.readUUID(), reader.readString(), reader.readString()};
+        module.folderPath = reader.readString();
+        module.components.resize(reader.readSize());
+        for (ComponentRecord & component : module.components) {
+            component.metadata = {reader.readUUID(), reader.readString(), reader.readString()};
+            component.interfaces.resize(reader.readSize());
+            for (uuids::uuid & interfaceUUID : component.interfaces) {
+                interfaceUUID = reader.readUUID();
+            }
+        }
+        module.interfaces.resize(reader.readSize());
+        for (MetadataRecord & interfaceRecord : module.interfaces) {
+            interfaceRecord = {reader.readUUID(), reader.readString(), reader.readString()};
+        }
+    }
+    if (!reader.good()) {
+        XPCF_LOG(info) << "Ignoring truncated module index cache " << m_cacheFilePath.generic_string();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_modules = std::move(modules);
+    m_modified = false;
+}
+
+void ModuleIndexCache::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_modified) {
+        return;
+    }
+    boost::system::error_code ec;
+    fs::create_directories(m_cacheFilePath.parent_path(), ec);
+    // the cache file is replaced at once : a concurrent process reads either the previous or the new cache
+    fs::path tmpFilePath = m_cacheFilePath;
+    tmpFilePath += fs::unique_path(".%%%%%%%%");
+    {
+        std::ofstream out(tmpFilePath.string(), std::ios::binary | std::ios::trunc);
+        CacheWriter writer(out);
+        writer.write(cacheMagic);
+        writer.write(cacheVersion);
+        writer.write(static_cast<uint32_t>(m_modules.size()));
+        for (auto & [modulePath, module] : m_modules) {
+            writer.write(modulePath);
+            writer.write(module.size);
+            writer.write(module.lastWriteTime);
+            writer.write(module.contentHash);
+            writer.write(module.metadata.uuid);
+            writer.write(module.metadata.name);
+            writer.write(module.metadata.description);
+            writer.write(module.folderPath);
+            writer.write(static_cast<uint32_t>(module.components.size()));
+            for (const ComponentRecord & component : module.components) {
+                writer.write(component.metadata.uuid);
+                writer.write(component.metadata.name);
+                writer.write(component.metadata.description);
+                writer.write(static_cast<uint32_t>(component.interfaces.size()));
+                for (const uuids::uuid & interfaceUUID : component.interfaces) {
+                    writer.write(interfaceUUID);
+                }
+            }
+            writer.write(static_cast<uint32_t>(module.interfaces.size()));
+            for (const MetadataRecord & interfaceRecord : module.interfaces) {
+                writer.write(interfaceRecord.uuid);
+                writer.write(interfaceRecord.name);
+                writer.write(interfaceRecord.description);
+            }
+        }
+        out.close();
+        if (!out) {
+            XPCF_LOG(warning) << "Unable to write the module index cache " << m_cacheFilePath.generic_string();
+            fs::remove(tmpFilePath, ec);
+            return;
+        }
+    }
+    fs::rename(tmpFilePath, m_cacheFilePath, ec);
+    if (ec) {
+        XPCF_LOG(warning) << "Unable to write the module index cache " << m_cacheFilePath.generic_string() << " : " << ec.message();
+        fs::remove(tmpFilePath, ec);
+        return;
+    }
+    m_modified = false;
+}
+
+SPtr<ModuleMetadata> ModuleIndexCache::find(const fs::path & modulePath)
+{
+    boost::system::error_code ec;
+    uint64_t size = fs::file_size(modulePath, ec);
+    if (ec) {
+        return nullptr;
+    }
+    int64_t lastWriteTime = fs::last_write_time(modulePath, ec);
+    if (ec) {
+        return nullptr;
+    }
+    std::string moduleKey = key(modulePath);
+    ModuleRecord module;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_modules.find(moduleKey);
+        if (it == m_modules.end() || it->second.size != size) {
+            return nullptr;
+        }
+        module = it->second;
+    }
+    if (module.lastWriteTime != lastWriteTime) {
+        // the library was touched or copied again : its content tells whether it changed
+        if (contentHash(modulePath) != module.contentHash) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_modules.find(moduleKey);
+        if (it != m_modules.end() && it->second.contentHash == module.contentHash && lastWriteTime < std::time(nullptr) - 1) {
+            it->second.lastWriteTime = lastWriteTime;
+            m_modified = true;
+        }
+    }
+    SPtr<ModuleMetadata> moduleInfos = utils::make_shared<ModuleMetadata>(module.metadata.name.c_str(), module.metadata.uuid,
+                                                                          module.metadata.description.c_str(), module.folderPath.c_str());
+    for (const ComponentRecord & component : module.components) {
+        SPtr<ComponentMetadata> componentInfo = utils::make_shared<ComponentMetadata>(component.metadata.name.c_str(), component.metadata.uuid,
+                                                                                      component.metadata.description.c_str());
+        for (const uuids::uuid & interfaceUUID : component.interfaces) {
+            componentInfo->addInterface(interfaceUUID);
+        }
+        moduleInfos->addComponent(componentInfo);
+    }
+    return moduleInfos;
+}
+
+std::vector<SPtr<InterfaceMetadata>> ModuleIndexCache::getInterfaces(const fs::path & modulePath) const
+{
+    std::vector<SPtr<InterfaceMetadata>> interfaces;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_modules.find(key(modulePath));
+    if (it == m_modules.end()) {
+        return interfaces;
+    }
+    for (const MetadataRecord & interfaceRecord : it->second.interfaces) {
+        interfaces.push_back(utils::make_shared<InterfaceMetadata>(interfaceRecord.name.c_str(), interfaceRecord.uuid, interfaceRecord.description.c_str()));
+    }
+    return interfaces;
+}
+
+void ModuleIndexCache::store(const fs::path & modulePath, SPtr<ModuleMetadata> moduleInfos, const std::vector<SPtr<InterfaceMetadata>> & interfaces)
+{
+    boost::system::error_code ec;
+    ModuleRecord module;
+    module.size = fs::file_size(modulePath, ec);
+    if (ec) {
+        return;
+    }
+    module.lastWriteTime = fs::last_write_time(modulePath, ec);
+    if (ec) {
+        return;
+    }
+    // the modification time has a one second resolution : a library written within the last second can still change
+    // with the same modification time. Its entry is then validated upon the content hash until it gets older.
+    if (module.lastWriteTime >= std::time(nullptr) - 1) {
+        module.lastWriteTime = -1;
+    }
+    module.contentHash = contentHash(modulePath);
+    module.metadata = {moduleInfos->getUUID(), moduleInfos->name(), moduleInfos->description()};
+    module.folderPath = moduleInfos->getPath();
+    for (SPtr<ComponentMetadata> componentInfo : moduleInfos->getComponentsMetadata()) {
+        ComponentRecord component;
+        component.metadata = {componentInfo->getUUID(), componentInfo->name(), componentInfo->description()};
+        for (uuids::uuid interfaceUUID : componentInfo->getInterfaces()) {
+            component.interfaces.push_back(interfaceUUID);
+        }
+        module.components.push_back(std::move(component));
+    }
+    for (SPtr<InterfaceMetadata> interfaceInfo : interfaces) {
+        module.interfaces.push_back({interfaceInfo->getUUID(), interfaceInfo->name(), interfaceInfo->description()});
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_modules[key(modulePath)] = std::move(module);
+    m_modified = true;
+}
+
+bool ModuleIndexCache::isUpToDate(const fs::path & modulePath) const
+{
+    boost::system::error_code ec;
+    uint64_t size = fs::file_size(modulePath, ec);
+    if (ec) {
+        return false;
+    }
+    uint64_t hash = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_modules.find(key(modulePath));
+        if (it == m_modules.end() || it->second.size != size) {
+            return false;
+        }
+        hash = it->second.contentHash;
+    }
+    return contentHash(modulePath) == hash;
+}
+
+void ModuleIndexCache::prune()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_modules.begin(); it != m_modules.end();) {
+        if (!fs::exists(it->first)) {
+            it = m_modules.erase(it);
+            m_modified = true;
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+}}} //namespace org::bcom::xpcf
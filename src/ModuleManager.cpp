@@ -22,24 +22,29 @@
 
 #include "xpcf/core/Exception.h"
 #include "private/xpcf/ModuleManager.h"
+#include "private/xpcf/Logger.h"
+#include "private/xpcf/ModuleIndexCache.h"
 #include "xpcf/module/ModuleFactory.h"
 #include "private/xpcf/PathBuilder.h"
+#include "private/xpcf/TaskPool.h"
 #include <iostream>
 #include <fstream>
 #include <boost/dll.hpp>
 #include <boost/locale.hpp>
 #include <boost/dll/shared_library.hpp>
 #include <boost/function.hpp>
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <utility>
 #include "private/xpcf/tinyxmlhelper.h"
 //#include <filesystem>
 
 using namespace std;
-#ifdef XPCF_WITH_LOGS
-namespace logging = boost::log;
-#endif
-
 namespace org { namespace bcom { namespace xpcf {
 
+XPCF_DEFINE_LOGGER("ModuleManager")
+
 std::atomic<ModuleManager*> ModuleManager::m_instance;
 std::mutex ModuleManager::m_mutex;
 
@@ -85,6 +90,20 @@ void checkSymbol(const boost::dll::shared_library & shlib, const std::string sym
     }
 }
 
+void checkAbiVersion(const boost::dll::shared_library & shlib, const fs::path & modulePath)
+{
+    // components of a module built upon another binary interface can't be called safely
+    uint32_t abiVersion = 0;
+    if (shlib.has(XPCF_GETABIVERSION)) {
+        abiVersion = shlib.get<uint32_t (void)>(XPCF_GETABIVERSION)();
+    }
+    if (abiVersion != XPCF_ABI_VERSION) {
+        throw ModuleException("Module '" + modulePath.generic_string() + "' was built upon xpcf ABI version " + std::to_string(abiVersion)
+                              + " instead of " + std::to_string(XPCF_ABI_VERSION) + " : rebuild the module",
+                              XPCFErrorCode::_ERROR_MODULE_ABI_MISMATCH);
+    }
+}
+
 boost::dll::shared_library validateModule(fs::path modulePath)// validation cache ?
 {
     if ( ! fs::exists(PathBuilder::appendModuleDecorations(modulePath))) {
@@ -99,7 +118,8 @@ boost::dll::shared_library validateModule(fs::path modulePath)// validation cach
     catch (boost::system::system_error & e) {
         throw ModuleException("Error loading module for file '" + modulePath.generic_string() + "'=> " +e.what());
     }
- //   checkSymbol(shlib, XPCF_GETXPCFVERSION);
+    checkSymbol(shlib, XPCF_GETXPCFVERSION);
+    checkAbiVersion(shlib, modulePath);
     checkSymbol(shlib, XPCF_GETMODULEUUID);
     checkSymbol(shlib, XPCF_GETMODULENAME);
     checkSymbol(shlib, XPCF_GETMODULEDESCRIPTION);
@@ -154,13 +174,7 @@ const char * ModuleManager::getXpcfVersion(const char* moduleName, const char* m
     boost::dll::shared_library shlib = validateModule(modulePath);
 
     try {
-        boost::function<const char* (void)> getXpcfVersion = boost::dll::import_symbol<const char* (void)>(
-                    modulePath, XPCF_GETXPCFVERSION, boost::dll::load_mode::append_decorations | boost::dll::load_mode::load_with_altered_search_path
-                    );
-/*        boost::function<const char* (void)> getXpcfVersion = boost::dll::import<const char * (void)>(
-                    modulePath, XPCF_GETXPCFVERSION, boost::dll::load_mode::append_decorations | boost::dll::load_mode::load_with_altered_search_path
-                    );*/
-        std::string xpcfVersion = getXpcfVersion();
+        std::string xpcfVersion = shlib.get<const char* (void)>(XPCF_GETXPCFVERSION)();
         return xpcfVersion.c_str();
     }
     catch (boost::system::system_error & e) {
@@ -181,81 +195,238 @@ SPtr<ModuleMetadata> ModuleManager::introspectModule(const char* moduleFilePath)
 }
 
 SPtr<ModuleMetadata> ModuleManager::introspectModule(fs::path modulePath)
+{
+    return registerModuleMetadata(readModuleMetadata(modulePath));
+}
+
+SPtr<ModuleMetadata> ModuleManager::readModuleMetadata(fs::path modulePath)
 {
     if (modulePath.is_relative()) {
         // when modulePath is relative, search modules in ~/.xpcf/modules/
         modulePath = PathBuilder::getXPCFHomePath() / "modules" / modulePath;
     }
+    // every entry point is fetched from the library opened by the validation
     boost::dll::shared_library shlib = validateModule(modulePath);
-    SPtr<ModuleMetadata> moduleInfos;
     try {
-//        boost::function<const char* (void)> getModuleUUID = boost::dll::import<const char * (void)>(
-        boost::function<const char* (void)> getModuleUUID = boost::dll::import_symbol<const char * (void)>(
-                    modulePath, XPCF_GETMODULEUUID, boost::dll::load_mode::append_decorations | boost::dll::load_mode::load_with_altered_search_path
-                    );
-//        boost::function<const char* (void)> getModuleName = boost::dll::import<const char * (void)>(
-        boost::function<const char* (void)> getModuleName = boost::dll::import_symbol<const char * (void)>(
-                    modulePath, XPCF_GETMODULENAME, boost::dll::load_mode::append_decorations| boost::dll::load_mode::load_with_altered_search_path
-                    );
-//        boost::function<const char* (void)> getModuleDescription = boost::dll::import<const char * (void)>(
-        boost::function<const char* (void)> getModuleDescription = boost::dll::import_symbol<const char * (void)>(
-                    modulePath, XPCF_GETMODULEDESCRIPTION, boost::dll::load_mode::append_decorations| boost::dll::load_mode::load_with_altered_search_path
-                    );
-//        boost::function<void (SRef<IModuleIndex>)> getModuleIndex = boost::dll::import<void (SRef<IModuleIndex>)>(
-        boost::function<void (SRef<IModuleIndex>)> getModuleIndex = boost::dll::import_symbol<void (SRef<IModuleIndex>)>(
-                    modulePath, XPCF_GETMODULEINDEX, boost::dll::load_mode::append_decorations| boost::dll::load_mode::load_with_altered_search_path
-                    );
-        if (getModuleUUID && getModuleName && getModuleIndex) {
-            std::string moduleUUIDStr = getModuleUUID();
-            std::string moduleName = getModuleName();
-            std::string moduleDescription = getModuleDescription();
-            xpcf::uuids::uuid moduleUUID = toUUID(moduleUUIDStr);
-            if (m_moduleMap.find(moduleUUID) == m_moduleMap.end()) {
-                moduleInfos = utils::make_shared<ModuleMetadata>(moduleName.c_str(), moduleUUID, moduleDescription.c_str(), modulePath.parent_path().generic_string().c_str());
-                getModuleIndex(moduleInfos);
-                m_moduleMap[moduleUUID] = moduleInfos;
+        std::string moduleUUIDStr = shlib.get<const char * (void)>(XPCF_GETMODULEUUID)();
+        std::string moduleName = shlib.get<const char * (void)>(XPCF_GETMODULENAME)();
+        std::string moduleDescription = shlib.get<const char * (void)>(XPCF_GETMODULEDESCRIPTION)();
+        SPtr<ModuleMetadata> moduleInfos = utils::make_shared<ModuleMetadata>(moduleName.c_str(), toUUID(moduleUUIDStr), moduleDescription.c_str(), modulePath.parent_path().generic_string().c_str());
+        shlib.get<void (SRef<IModuleIndex>)>(XPCF_GETMODULEINDEX)(moduleInfos);
+        return moduleInfos;
+    }
+    catch (boost::system::system_error & e) {
+        throw ModuleException(e.what(),xpcf::XPCFErrorCode::_ERROR_MODULE_MISSINGXPCF_ENTRY);
+    }
+}
+
+SPtr<ModuleMetadata> ModuleManager::registerModuleMetadata(SPtr<ModuleMetadata> moduleInfos)
+{
+    std::lock_guard<std::mutex> lock(m_moduleMapMutex);
+    //Module has already been loaded in the library
+    return m_moduleMap.emplace(moduleInfos->getUUID(), moduleInfos).first->second;
+}
+
+void ModuleManager::introspectModules(const std::vector<fs::path> & modulesPaths,
+                                      const std::function<void(const fs::path &, SPtr<ModuleMetadata>, bool)> & declareModule,
+                                      ModuleIndexCache * cache)
+{
+    std::vector<SPtr<ModuleMetadata>> modulesInfos(modulesPaths.size());
+    std::vector<char> cached(modulesPaths.size(), false);
+    std::vector<std::exception_ptr> errors(modulesPaths.size());
+    TaskGroup group;
+    for (std::size_t i = 0; i < modulesPaths.size(); i++) {
+        group.run([this, &modulesPaths, &modulesInfos, &cached, &errors, cache, i]() {
+            try {
+                if (cache != nullptr) {
+                    modulesInfos[i] = cache->find(modulesPaths[i]);
+                    cached[i] = (modulesInfos[i] != nullptr);
+                }
+                if (!cached[i]) {
+                    modulesInfos[i] = readModuleMetadata(modulesPaths[i]);
+                }
             }
-            else { //Module has already been loaded in the library
-                moduleInfos = m_moduleMap.at(moduleUUID);
+            catch (...) {
+                errors[i] = std::current_exception();
             }
+        });
+    }
+    group.wait();
+    // the modules are registered and declared in the paths order, whatever the introspections completion order
+    for (std::size_t i = 0; i < modulesPaths.size(); i++) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
         }
+        SPtr<ModuleMetadata> moduleInfos = registerModuleMetadata(modulesInfos[i]);
+        // the cached metadata are complete, even when the module was already registered without its components interfaces
+        declareModule(modulesPaths[i], cached[i] ? modulesInfos[i] : moduleInfos, cached[i]);
     }
-    catch (boost::system::system_error & e) {
-        throw ModuleException(e.what(),xpcf::XPCFErrorCode::_ERROR_MODULE_MISSINGXPCF_ENTRY);
+}
+
+class ModuleHandle {
+public:
+    using GetComponentFunction = XPCFErrorCode(const uuids::uuid &, SRef<IComponentIntrospect>&);
+    using GetComponentFactoryTableFunction = const ComponentFactoryTable * (void);
+    ModuleHandle(const uuids::uuid & moduleUUID, boost::dll::shared_library && library);
+    SRef<IComponentIntrospect> create(const uuids::uuid & componentUUID) const;
+
+    const uuids::uuid m_moduleUUID;
+    std::atomic<uint32_t> m_componentsCount{0};
+
+private:
+    // the library is closed with the last reference upon the handle
+    boost::dll::shared_library m_library;
+    GetComponentFunction * m_getComponent;
+    // components creation functions sorted by uuid, empty for the modules without XPCF_getComponentFactoryTable entry point
+    std::vector<std::pair<uuids::uuid, SRef<IComponentIntrospect> (*)(void)>> m_factories;
+};
+
+ModuleHandle::ModuleHandle(const uuids::uuid & moduleUUID, boost::dll::shared_library && library):m_moduleUUID(moduleUUID),
+    m_library(std::move(library)), m_getComponent(&m_library.get<GetComponentFunction>(XPCF_GETCOMPONENT))
+{
+    if (!m_library.has(XPCF_GETCOMPONENTFACTORYTABLE)) {
+        return;
     }
-    return moduleInfos;
+    const ComponentFactoryTable * table = m_library.get<GetComponentFactoryTableFunction>(XPCF_GETCOMPONENTFACTORYTABLE)();
+    for (std::size_t i = 0; i < table->size; i++) {
+        const ComponentFactoryEntry & entry = table->entries[i];
+        m_factories.emplace_back(detail::makeUUID(entry.uuid, std::make_index_sequence<16>{}), entry.create);
+    }
+    // uuids compare as their bytes : the table order is kept, sorting again covers hand written tables
+    std::sort(m_factories.begin(), m_factories.end(), [](const auto & left, const auto & right) { return left.first < right.first; });
 }
 
-void ModuleManager::addModuleRef(const uuids::uuid& moduleUUID)
+SRef<IComponentIntrospect> ModuleHandle::create(const uuids::uuid & componentUUID) const
 {
+    auto it = std::lower_bound(m_factories.begin(), m_factories.end(), componentUUID,
+                               [](const auto & factory, const uuids::uuid & uuid) { return factory.first < uuid; });
+    if (it != m_factories.end() && it->first == componentUUID) {
+        return it->second();
+    }
+    // XPCF_getComponent can create components missing from the module index
+    SRef<IComponentIntrospect> componentRef;
+    m_getComponent(componentUUID, componentRef);
+    return componentRef;
+}
+
+SRef<ModuleHandle> ModuleManager::moduleHandle(SPtr<ModuleMetadata> moduleInfos)
+{
+    const uuids::uuid & moduleUUID = moduleInfos->getUUID();
+    SRef<const ModuleHandleMap> modules = utils::atomic_load(&m_modules);
+    auto it = modules->find(moduleUUID);
+    if (it != modules->end()) {
+        return it->second;
+    }
+    // components can be created concurrently from several threads : the module is opened once.
+    // The library is opened outside of the lock, so that opening a module doesn't delay the other modules
+    std::promise<SRef<ModuleHandle>> loading;
+    {
+        std::unique_lock<std::mutex> lock(m_modulesMutex);
+        modules = utils::atomic_load(&m_modules);
+        it = modules->find(moduleUUID);
+        if (it != modules->end()) {
+            return it->second;
+        }
+        auto pendingIt = m_pendingModules.find(moduleUUID);
+        if (pendingIt != m_pendingModules.end()) {
+            std::shared_future<SRef<ModuleHandle>> pending = pendingIt->second;
+            lock.unlock();
+            return pending.get();
+        }
+        m_pendingModules[moduleUUID] = loading.get_future().share();
+    }
+    SRef<ModuleHandle> module;
+    try {
+        module = utils::make_shared<ModuleHandle>(moduleUUID, validateModule(moduleInfos));
+    }
+    catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(m_modulesMutex);
+            m_pendingModules.erase(moduleUUID);
+        }
+        loading.set_exception(std::current_exception());
+        throw;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_modulesMutex);
+        modules = utils::atomic_load(&m_modules);
+        SRef<ModuleHandleMap> newModules = utils::make_shared<ModuleHandleMap>(*modules);
+        (*newModules)[moduleUUID] = module;
+        utils::atomic_store(&m_modules, SRef<const ModuleHandleMap>(newModules));
+        m_pendingModules.erase(moduleUUID);
+    }
+    loading.set_value(module);
+    XPCF_LOG(info) << "ModuleManager::moduleHandle module "<<moduleInfos->getFullPath()<<" loaded";
+    return module;
+}
 
+void ModuleManager::prefetchModule(SPtr<ModuleMetadata> moduleInfos)
+{
+    if (isModuleLoaded(moduleInfos->getUUID())) {
+        return;
+    }
+    TaskPool::instance().post([this, moduleInfos]() {
+        try {
+            moduleHandle(moduleInfos);
+        }
+        catch (const std::exception & e) {
+            // the error is raised again by the first component creation from the module
+            XPCF_LOG(warning) << "ModuleManager::prefetchModule module "<<moduleInfos->getFullPath()<<" not loaded : "<<e.what();
+        }
+    });
+}
+
+bool ModuleManager::isModuleLoaded(const uuids::uuid & moduleUUID) const
+{
+    SRef<const ModuleHandleMap> modules = utils::atomic_load(&m_modules);
+    return modules->find(moduleUUID) != modules->end();
 }
 
-void ModuleManager::releaseModuleRef(const uuids::uuid& moduleUUID)
+uint32_t ModuleManager::getComponentsCount(const uuids::uuid & moduleUUID) const
 {
+    SRef<const ModuleHandleMap> modules = utils::atomic_load(&m_modules);
+    auto it = modules->find(moduleUUID);
+    if (it == modules->end()) {
+        return 0;
+    }
+    return it->second->m_componentsCount;
+}
 
+void ModuleManager::releaseModuleRef(const SRef<ModuleHandle> & module)
+{
+    if (module->m_componentsCount.fetch_sub(1, std::memory_order_acq_rel) != 1 || !m_modulesUnloading) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_modulesMutex);
+    SRef<const ModuleHandleMap> modules = utils::atomic_load(&m_modules);
+    auto it = modules->find(module->m_moduleUUID);
+    // a component may have been created meanwhile, or the module already reloaded
+    if (it == modules->end() || it->second != module || module->m_componentsCount != 0) {
+        return;
+    }
+    SRef<ModuleHandleMap> newModules = utils::make_shared<ModuleHandleMap>(*modules);
+    newModules->erase(module->m_moduleUUID);
+    utils::atomic_store(&m_modules, SRef<const ModuleHandleMap>(newModules));
+    // the library is closed once the creations still running upon the handle are done
+    XPCF_LOG(info) << "ModuleManager::releaseModuleRef module uuid="<<uuids::to_string(module->m_moduleUUID)<<" unloaded";
 }
 
 SRef<IComponentIntrospect> ModuleManager::createComponent(SPtr<ModuleMetadata> moduleInfos, const uuids::uuid& componentUUID)
 {
-    SRef<IComponentIntrospect> componentRef;
-    boost::dll::shared_library shlib = validateModule(moduleInfos);
-    if (m_funcMap.find(moduleInfos->getUUID()) == m_funcMap.end()) {
-//        m_funcMap[moduleInfos->getUUID()]=boost::dll::import<XPCFErrorCode(const uuids::uuid &, SRef<IComponentIntrospect>&)>(
-        m_funcMap[moduleInfos->getUUID()]=boost::dll::import_symbol<XPCFErrorCode(const uuids::uuid &, SRef<IComponentIntrospect>&)>(
-                    moduleInfos->getFullPath(), XPCF_GETCOMPONENT, boost::dll::load_mode::append_decorations | boost::dll::load_mode::load_with_altered_search_path
-                    );
-    }
-
-    if (m_funcMap.at(moduleInfos->getUUID())) {
-        XPCFErrorCode errCode = m_funcMap.at(moduleInfos->getUUID())(componentUUID, componentRef);
-        if (componentRef) {
-            addModuleRef(moduleInfos->getUUID());
-        } 
-        else {
-            std::string what = "Unable to find component uuid=";
-            what.append(uuids::to_string(componentUUID));
-            throw xpcf::ConfigurationException(what);
+    SRef<ModuleHandle> module = moduleHandle(moduleInfos);
+    SRef<IComponentIntrospect> componentRef = module->create(componentUUID);
+    if (!componentRef) {
+        std::string what = "Unable to find component uuid=";
+        what.append(uuids::to_string(componentUUID));
+        throw xpcf::ConfigurationException(what);
+    }
+    // the component keeps its module loaded until it is unloaded
+    ComponentBase * component = dynamic_cast<ComponentBase *>(componentRef.get());
+    if (component != nullptr) {
+        module->m_componentsCount.fetch_add(1, std::memory_order_relaxed);
+        if (!component->setModule(module)) {
+            // the module returned an instance it already created
+            module->m_componentsCount.fetch_sub(1, std::memory_order_relaxed);
         }
     }
     return componentRef;
@@ -291,10 +462,8 @@ XPCFErrorCode ModuleManager::saveModuleInformations(const char * xmlFilePath, co
         xmlDoc.InsertFirstChild(xmlRoot);
     }
     try {
-#ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Parsing XML from "<<xmlFilePath<<" config file";
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"NOTE : Command line arguments are overloaded with config file parameters";
-#endif
+        XPCF_LOG(info) << "Parsing XML from "<<xmlFilePath<<" config file";
+        XPCF_LOG(info) << "NOTE : Command line arguments are overloaded with config file parameters";
         //TODO : check each element exists before using it !
         // TODO : before adding a module, we MUST check if a module node with the same UUID exists !!
         std::cout<<"ModuleManager::saveModuleInformations ===> creating module XmlNode"<<std::endl;
@@ -325,9 +494,7 @@ XPCFErrorCode ModuleManager::saveModuleInformations(const char * xmlFilePath, co
         tinyxml2::XMLError eResult = xmlDoc.SaveFile(xmlFilePath);
     }
     catch (const std::runtime_error & e) {
-#ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"XML parsing file "<<xmlFilePath<<" failed with error : "<<e.what();
-#endif
+        XPCF_LOG(info) << "XML parsing file "<<xmlFilePath<<" failed with error : "<<e.what();
         return XPCFErrorCode::_FAIL;
     }
     return result;
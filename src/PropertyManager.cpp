@@ -26,6 +26,7 @@
 #include "xpcf/core/Exception.h"
 #include "xpcf/module/ModuleFactory.h"
 #include "private/xpcf/PropertyManager.h"
+#include "private/xpcf/Logger.h"
 #include "private/xpcf/PathBuilder.h"
 
 #include "private/xpcf/tinyxmlhelper.h"
@@ -35,17 +36,13 @@
 using namespace std;
 using placeholders::_1;
 using placeholders::_2;
-//namespace logging = boost::log;
-
-namespace fs = boost::filesystem;
-#ifdef XPCF_WITH_LOGS
-namespace logging = boost::log;
-#endif
-
+//namespace fs = boost::filesystem;
 XPCF_DEFINE_FACTORY_CREATE_INSTANCE(org::bcom::xpcf::PropertyManager);
 
 namespace org { namespace bcom { namespace xpcf {
 
+XPCF_DEFINE_LOGGER("PropertyManager")
+
 constexpr const char * XMLCOMPONENTNODE = "component";
 constexpr const char * XMLCONFIGURENODE = "configure";
 
@@ -62,10 +59,7 @@ PropertyManager::PropertyManager():ComponentBase(toUUID<PropertyManager>())
     declareInterface<AbstractPropertyManager>(this);
     declareInjectable<IAliasManager>(m_aliasManager);
     declareInjectable<IRegistryManager>(m_registry);
-#ifdef XPCF_WITH_LOGS
-    m_logger.add_attribute("ClassName", boost::log::attributes::constant<std::string>("PropertyManager"));
-    BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Constructor PropertyManager::PropertyManager () called!";
-#endif
+    XPCF_LOG(info) << "Constructor PropertyManager::PropertyManager () called!";
 }
 
 map<IProperty::PropertyType, std::string> propertyTypeToStrMap = {
@@ -386,10 +380,8 @@ XPCFErrorCode PropertyManager::configure(std::function<bool(tinyxml2::XMLElement
     //TODO: filepath must be wrapped in an utf8 observer !
     enum tinyxml2::XMLError loadOkay = doc.LoadFile(filepath);
     if (loadOkay == 0) {
-#ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"Parsing XML from "<<filepath<<" config file";
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"NOTE : Command line arguments are overloaded with config file parameters";
-#endif
+        XPCF_LOG(info) << "Parsing XML from "<<filepath<<" config file";
+        XPCF_LOG(info) << "NOTE : Command line arguments are overloaded with config file parameters";
         //TODO : check each element exists before using it !
         // a check should be performed upon announced module uuid and inner module uuid
         tinyxml2::XMLElement * rootElt = doc.RootElement();
@@ -610,9 +602,7 @@ XPCFErrorCode PropertyManager::serialize(const uuids::uuid & componentUUID, SRef
         return e.getErrorCode();
     }
     catch (const std::runtime_error & e) {
-#ifdef XPCF_WITH_LOGS
-        BOOST_LOG_SEV(m_logger, logging::trivial::info)<<"XML parsing file "<<filepath<<" failed with error : "<<e.what();
-#endif
+        XPCF_LOG(info) << "XML parsing file "<<filepath<<" failed with error : "<<e.what();
         return XPCFErrorCode::_FAIL;
     }
     return result;
@@ -21,6 +21,7 @@
  */
 
 #include "xpcf/api/IConfigurable.h"
+#include "private/xpcf/ModuleIndexCache.h"
 #include "private/xpcf/ModuleManager.h"
 #include "private/xpcf/Registry.h"
 #include "xpcf/component/ComponentFactory.h"
@@ -31,7 +32,9 @@
 
 
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <fstream>
 
 using namespace std;
@@ -88,24 +91,25 @@ XPCFErrorCode Registry::loadModuleMetadata(const char * moduleName,
     return XPCFErrorCode::_SUCCESS;
 }
 
-template <class T> XPCFErrorCode Registry::loadModules(fs::path folderPath)
+template <class T> std::vector<fs::path> Registry::findModules(fs::path folderPath) const
 {
-    //TODO : what strategy to report error of load for a dedicated file but load others ?
-    XPCFErrorCode result = XPCFErrorCode::_SUCCESS;
     static_assert(std::is_same<T,fs::directory_iterator>::value || std::is_same<T,fs::recursive_directory_iterator>::value,
             "Type passed to ComponentManager::load is neither a directory_iterator nor a recursive_directory_iterator");
+    std::vector<fs::path> modulesPaths;
     for (fs::directory_entry& x : T(folderPath)) {
         if (PathBuilder::is_shared_library(x.path())) {
             fs::path modulePath = x.path().parent_path();
             fs::path moduleName = x.path().filename();
             fs::detail::utf8_codecvt_facet utf8;
-            result = loadModuleMetadata(moduleName.string(utf8).c_str(),modulePath.string(utf8).c_str());
+            modulesPaths.push_back(PathBuilder::buildModuleFilePath(moduleName.string(utf8).c_str(),modulePath.string(utf8).c_str()));
         }
     }
-    return result;
+    // the directory iteration order depends on the file system : sorting keeps the declaration order stable
+    std::sort(modulesPaths.begin(), modulesPaths.end());
+    return modulesPaths;
 }
 
-XPCFErrorCode Registry::loadModules(const char * folderPathStr, bool bRecurse)
+XPCFErrorCode Registry::findModules(const char * folderPathStr, bool bRecurse, std::vector<fs::path> & modulesPaths) const
 {
     if (folderPathStr == nullptr) {
         return XPCFErrorCode::_ERROR_NULL_POINTER;
@@ -120,17 +124,106 @@ XPCFErrorCode Registry::loadModules(const char * folderPathStr, bool bRecurse)
     if ( !fs::is_directory(folderPath)) {
         return XPCFErrorCode::_FAIL;
     }
-    XPCFErrorCode result = XPCFErrorCode::_SUCCESS;
 
     if (bRecurse) {
-        result = loadModules<fs::recursive_directory_iterator>(folderPath);
+        modulesPaths = findModules<fs::recursive_directory_iterator>(folderPath);
     }
     else {
-        result = loadModules<fs::directory_iterator>(folderPath);
+        modulesPaths = findModules<fs::directory_iterator>(folderPath);
+    }
+    return XPCFErrorCode::_SUCCESS;
+}
+
+void Registry::loadModules(const std::vector<fs::path> & modulesPaths, bool rebuildCache)
+{
+    //TODO : what strategy to report error of load for a dedicated file but load others ?
+    std::unique_ptr<ModuleIndexCache> cache;
+    if (m_moduleIndexCacheEnabled || rebuildCache) {
+        cache = std::make_unique<ModuleIndexCache>(moduleIndexCachePath());
+        cache->load();
     }
+    auto declareModule = [this, &cache](const fs::path & modulePath, SPtr<ModuleMetadata> moduleInfos, bool cached) {
+        if (cached) {
+            declareModuleMetadata(moduleInfos, cache->getInterfaces(modulePath));
+            return;
+        }
+        declareModuleMetadata(moduleInfos);
+        if (cache) {
+            std::vector<SPtr<InterfaceMetadata>> interfaces;
+            for (SRef<ComponentMetadata> componentInfo : moduleInfos->getComponentsMetadata()) {
+                for (uuids::uuid interfaceUUID : componentInfo->getInterfaces()) {
+                    SPtr<InterfaceMetadata> interfaceInfo = findInterfaceMetadata(interfaceUUID);
+                    if (interfaceInfo && std::find(interfaces.begin(), interfaces.end(), interfaceInfo) == interfaces.end()) {
+                        interfaces.push_back(interfaceInfo);
+                    }
+                }
+            }
+            cache->store(modulePath, moduleInfos, interfaces);
+        }
+    };
+    // a rebuild introspects every module and replaces its cache entry
+    ModuleManager::instance()->introspectModules(modulesPaths, declareModule, rebuildCache ? nullptr : cache.get());
+    if (cache) {
+        if (rebuildCache) {
+            cache->prune();
+        }
+        cache->save();
+    }
+}
+
+void Registry::setModuleIndexCachePath(const char * cacheFilePath)
+{
+    m_moduleIndexCachePath = PathBuilder::getUTF8PathObserver(cacheFilePath);
+}
+
+fs::path Registry::moduleIndexCachePath() const
+{
+    if (m_moduleIndexCachePath.empty()) {
+        return ModuleIndexCache::defaultPath();
+    }
+    return m_moduleIndexCachePath;
+}
+
+XPCFErrorCode Registry::loadModules(const char * folderPathStr, bool bRecurse)
+{
+    std::vector<fs::path> modulesPaths;
+    XPCFErrorCode result = findModules(folderPathStr, bRecurse, modulesPaths);
+    if (result != XPCFErrorCode::_SUCCESS) {
+        return result;
+    }
+    loadModules(modulesPaths, false);
+    return result;
+}
+
+XPCFErrorCode Registry::buildModuleIndexCache(const char * folderPathStr, bool bRecurse)
+{
+    std::vector<fs::path> modulesPaths;
+    XPCFErrorCode result = findModules(folderPathStr, bRecurse, modulesPaths);
+    if (result != XPCFErrorCode::_SUCCESS) {
+        return result;
+    }
+    loadModules(modulesPaths, true);
     return result;
 }
 
+std::vector<std::string> Registry::verifyModuleIndexCache(const char * folderPathStr, bool bRecurse) const
+{
+    std::vector<std::string> outdatedModules;
+    std::vector<fs::path> modulesPaths;
+    if (findModules(folderPathStr, bRecurse, modulesPaths) != XPCFErrorCode::_SUCCESS) {
+        return outdatedModules;
+    }
+    ModuleIndexCache cache(moduleIndexCachePath());
+    cache.load();
+    for (const fs::path & modulePath : modulesPaths) {
+        if (!cache.isUpToDate(modulePath)) {
+            fs::detail::utf8_codecvt_facet utf8;
+            outdatedModules.push_back(modulePath.generic_string(utf8));
+        }
+    }
+    return outdatedModules;
+}
+
 SRef<RegistryContext> Registry::getContext() const
 {
     return m_context;
@@ -230,6 +323,17 @@ void Registry::addInterfaceMetadata(SPtr<InterfaceMetadata> metadata)
     addMetadata<InterfaceMetadata>(metadata, m_context->interfacesVector, m_context->interfacesMap);
 }
 
+void Registry::declareComponentInterface(SRef<ComponentMetadata> componentInfo, SRef<InterfaceMetadata> interfaceInfo)
+{
+    autobind(interfaceInfo->getUUID(),componentInfo->getUUID());
+    if (m_autoAlias) {
+        if (!m_aliasManager->aliasExists(IAliasManager::Type::Interface, interfaceInfo->name())) {
+            m_aliasManager->declareAlias(IAliasManager::Type::Interface, interfaceInfo->name(), interfaceInfo->getUUID());
+        }
+    }
+    addInterfaceMetadata(interfaceInfo);
+}
+
 void Registry::declareModuleMetadata(SPtr<ModuleMetadata> moduleInfos)
 {
     addModuleMetadata(moduleInfos);
@@ -242,18 +346,36 @@ void Registry::declareModuleMetadata(SPtr<ModuleMetadata> moduleInfos)
                 m_aliasManager->declareAlias(IAliasManager::Type::Component, componentInfo->name(), componentInfo->getUUID());
             }
         }
-        std::vector<SRef<InterfaceMetadata>> interfaceVector;
         SRef<xpcf::IComponentIntrospect> rIntrospect = getModuleManagerInstance()->createComponent(moduleInfos, componentInfo->getUUID());
         for (uuids::uuid interfaceUUID : rIntrospect->getInterfaces()) {
-            autobind(interfaceUUID,componentInfo->getUUID());
             SRef<InterfaceMetadata> interfaceInfo = utils::make_shared<InterfaceMetadata>(rIntrospect->getMetadata(interfaceUUID));
-            if (m_autoAlias) {
-                if (!m_aliasManager->aliasExists(IAliasManager::Type::Interface, interfaceInfo->name())) {
-                    m_aliasManager->declareAlias(IAliasManager::Type::Interface, interfaceInfo->name(), interfaceInfo->getUUID());
-                }
-            }
             componentInfo->addInterface(interfaceInfo->getUUID());
-            addInterfaceMetadata(interfaceInfo);
+            declareComponentInterface(componentInfo, interfaceInfo);
+        }
+    }
+}
+
+void Registry::declareModuleMetadata(SPtr<ModuleMetadata> moduleInfos, const std::vector<SPtr<InterfaceMetadata>> & interfaces)
+{
+    std::map<uuids::uuid, SPtr<InterfaceMetadata>> interfacesMap;
+    for (SPtr<InterfaceMetadata> interfaceInfo : interfaces) {
+        interfacesMap[interfaceInfo->getUUID()] = interfaceInfo;
+    }
+    addModuleMetadata(moduleInfos);
+    for (SRef<ComponentMetadata> componentInfo : moduleInfos->getComponentsMetadata()) {
+        if (! mapContains(m_context->componentModuleUUIDMap, componentInfo->getUUID()) ) {
+            m_context->componentModuleUUIDMap[componentInfo->getUUID()] = moduleInfos->getUUID();
+        }
+        if (m_autoAlias) {
+            if (!m_aliasManager->aliasExists(IAliasManager::Type::Component, componentInfo->name())) {
+                m_aliasManager->declareAlias(IAliasManager::Type::Component, componentInfo->name(), componentInfo->getUUID());
+            }
+        }
+        for (uuids::uuid interfaceUUID : componentInfo->getInterfaces()) {
+            SPtr<InterfaceMetadata> interfaceInfo = findMetadata<InterfaceMetadata>(interfaceUUID, interfacesMap);
+            if (interfaceInfo) {
+                declareComponentInterface(componentInfo, interfaceInfo);
+            }
         }
     }
 }
@@ -0,0 +1,131 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief task pool used to build independent parts of a component graph concurrently
+ * @date 2026-10-17
+ */
+
+#include "private/xpcf/TaskPool.h"
+#include <algorithm>
+
+namespace org { namespace bcom { namespace xpcf {
+
+void TaskPool::Task::run()
+{
+    if (m_claimed.exchange(true)) {
+        return;
+    }
+    try {
+        m_func();
+        m_promise.set_value();
+    }
+    catch (...) {
+        m_promise.set_exception(std::current_exception());
+    }
+}
+
+TaskPool & TaskPool::instance()
+{
+    // the thread waiting for a group also runs tasks : keep one hardware thread for it
+    static TaskPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+TaskPool::TaskPool(std::size_t threadsCount)
+{
+    for (std::size_t i = 0; i < threadsCount; i++) {
+        m_workers.emplace_back([this] { work(); });
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (auto & worker : m_workers) {
+        worker.join();
+    }
+}
+
+void TaskPool::submit(const SRef<Task> & task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(task);
+    }
+    m_condition.notify_one();
+}
+
+void TaskPool::post(const std::function<void(void)> & func)
+{
+    submit(utils::make_shared<Task>(func));
+}
+
+void TaskPool::work()
+{
+    while (true) {
+        SRef<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+            if (m_stop) {
+                return;
+            }
+            task = m_tasks.front();
+            m_tasks.pop_front();
+        }
+        // the task may already have been run by the thread waiting for its group
+        task->run();
+    }
+}
+
+TaskGroup::~TaskGroup()
+{
+    // tasks refer to the caller stack : never leave them running
+    for (auto & task : m_tasks) {
+        task->run();
+        task->wait();
+    }
+}
+
+void TaskGroup::run(const std::function<void(void)> & func)
+{
+    SRef<TaskPool::Task> task = utils::make_shared<TaskPool::Task>(func);
+    m_tasks.push_back(task);
+    m_pool.submit(task);
+}
+
+void TaskGroup::wait()
+{
+    for (auto & task : m_tasks) {
+        task->run();
+    }
+    for (auto & task : m_tasks) {
+        task->wait();
+    }
+    std::vector<SRef<TaskPool::Task>> tasks;
+    std::swap(tasks, m_tasks);
+    for (auto & task : tasks) {
+        task->get();
+    }
+}
+
+}}}
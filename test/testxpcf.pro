@@ -40,15 +40,19 @@ include (../builddefs/qmake/templateappconfig.pri)
 #HEADERS += \
 #    TestDefines.h
 
-SOURCES += \
-    \   # xpcf_dynamic_test.cpp #\
-    #xpcf_properties_test.cpp \
-    #xpcf_dynamic_test.cpp #\
-    #xpcf_threading_test.cpp 
-    #xpcf_xml_test.cpp
-    #xpcf_dynamic_test_copy.cpp
-#    xpcf_in_code_test.cpp
-    xpcf_xml_test.cpp
+# qmake CONFIG+=xpcf_dynamic_tests builds the test_xpcf test set of the meson and bazel builds.
+# The performance tests load the module xpcfTestModule/xpcfTestModule.pro builds from the testxpcf folder
+xpcf_dynamic_tests {
+    SOURCES += \
+        xpcf_dynamic_test.cpp \
+        xpcf_properties_test.cpp \
+        xpcf_performance_test.cpp
+} else {
+    #SOURCES += xpcf_threading_test.cpp
+    #SOURCES += xpcf_dynamic_test_copy.cpp
+    #SOURCES += xpcf_in_code_test.cpp
+    SOURCES += xpcf_xml_test.cpp
+}
 
 unix {
     QMAKE_CXXFLAGS += --coverage
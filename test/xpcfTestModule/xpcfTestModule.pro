@@ -0,0 +1,39 @@
+QT       -= core gui
+CONFIG -= app_bundle qt
+
+# module without components factory table : testxpcf loads it from its own folder
+TARGET = xpcfTestModule
+FRAMEWORK = $${TARGET}
+VERSION=2.7.0
+DEFINES += MYVERSION=$${VERSION}
+
+CONFIG += c++17
+CONFIG += shared
+
+DEPENDENCIESCONFIG = shared
+DEFINES += USE_XPCF_BOOST
+#NOTE : CONFIG as staticlib or sharedlib, DEPENDENCIESCONFIG as staticlib or sharedlib and PROJECTDEPLOYDIR MUST BE DEFINED BEFORE templatelibbundle.pri inclusion
+include (../../builddefs/qmake/templatelibconfig.pri)
+
+DEFINES += BOOST_ALL_NO_LIB
+DEFINES += BOOST_ALL_DYN_LINK
+
+SOURCES += \
+    xpcfTestModule_main.cpp
+
+linux {
+    LIBS += -ldl
+}
+
+macx {
+    QMAKE_MAC_SDK= macosx
+    QMAKE_CXXFLAGS += -std=c++17 -fPIC
+}
+
+win32 {
+    DEFINES += _X86_VC12_TARGET_
+    DEFINES += MBCS _MBCS
+}
+
+DISTFILES += \
+    packagedependencies.txt
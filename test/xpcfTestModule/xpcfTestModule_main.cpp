@@ -0,0 +1,63 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief test module without components factory table
+ * @date 2026-10-17
+ */
+
+#include "xpcf/component/ComponentBase.h"
+#include "xpcf/module/ModuleFactory.h"
+
+namespace xpcf = org::bcom::xpcf;
+
+namespace testmodule {
+
+class TableLessComponent : public xpcf::ComponentBase {
+public:
+    TableLessComponent();
+    ~TableLessComponent() override = default;
+    void unloadComponent() override final { delete this; }
+};
+
+}
+
+XPCF_DEFINE_COMPONENT_TRAITS(testmodule::TableLessComponent, "9A4E2C71-B6D3-4F08-8E5A-1C7B3D9F0E24", "TableLessComponent", "component of a module without components factory table")
+
+namespace testmodule {
+
+TableLessComponent::TableLessComponent():ComponentBase(xpcf::toUUID<TableLessComponent>())
+{
+}
+
+}
+
+XPCF_DECLARE_MODULE("D0B8E6F4-3A17-4C92-B5E1-7F29A4C8E603","xpcfTestModule","module declaring its components without XPCF_END_COMPONENTS_DECLARATION")
+
+extern "C" XPCF_MODULEHOOKS_API xpcf::XPCFErrorCode XPCF_getComponent(const xpcf::uuids::uuid& componentUUID,SRef<xpcf::IComponentIntrospect>& interfaceRef)
+{
+    return xpcf::tryCreateComponent<testmodule::TableLessComponent>(componentUUID,interfaceRef);
+}
+
+/**
+  * The module index is written by hand, as modules built before the components factory table did :
+  * the module doesn't export XPCF_getComponentFactoryTable and its components are created through XPCF_getComponent.
+  */
+extern "C" XPCF_MODULEHOOKS_API void XPCF_getModuleIndex(SRef<xpcf::IModuleIndex> moduleIndexRef)
+{
+    moduleIndexRef->declareComponent<testmodule::TableLessComponent>();
+}
@@ -699,6 +699,43 @@ BOOST_FIXTURE_TEST_CASE( test_factory_emptycontext,XpcfFixture,* boost::unit_tes
     xpcfComponentManager->clear();
     emptyFactory->clear();
 }
+
+BOOST_FIXTURE_TEST_CASE( test_factory_resolution_plans,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+
+    BOOST_TEST_MESSAGE("Resolve IGuitar default binding : first resolution records the plan, second replays it");
+    SRef<IGuitar> guitar1 = xpcfComponentManager->resolve<IGuitar>();
+    SRef<IGuitar> guitar2 = xpcfComponentManager->resolve<IGuitar>();
+    BOOST_TEST_REQUIRE(guitar1.get() != guitar2.get(), "transient components must be distinct instances");
+    BOOST_TEST_REQUIRE(guitar1->getGuitarBrand() == "Takamine");
+    BOOST_TEST_REQUIRE(guitar2->getGuitarBrand() == "Takamine");
+    BOOST_TEST_REQUIRE(guitar1->getTuneType() == guitar2->getTuneType(), "replayed plan must inject and configure the same way");
+
+    SRef<IGuitarist> guitarist1 = xpcfComponentManager->resolve<IGuitarist>();
+    SRef<IGuitarist> guitarist2 = xpcfComponentManager->resolve<IGuitarist>();
+    BOOST_TEST_REQUIRE(guitarist1.get() == guitarist2.get(), "singleton must be the same instance upon plan replay");
+
+    SRef<IElectricGuitar> jacksonGuitar1 = xpcfComponentManager->resolve<IElectricGuitar>("jacksonGuitar");
+    SRef<IElectricGuitar> jacksonGuitar2 = xpcfComponentManager->resolve<IElectricGuitar>("jacksonGuitar");
+    BOOST_TEST_REQUIRE(jacksonGuitar2->bindTo<IGuitar>()->getGuitarBrand() == "Jackson");
+    BOOST_TEST_REQUIRE(jacksonGuitar1->bindTo<IGuitar>()->getTuneType() == jacksonGuitar2->bindTo<IGuitar>()->getTuneType());
+
+    auto guitars1 = xpcfComponentManager->getFactory()->resolveAll(xpcf::toUUID<IElectricGuitar>());
+    auto guitars2 = xpcfComponentManager->getFactory()->resolveAll(xpcf::toUUID<IElectricGuitar>());
+    BOOST_TEST_REQUIRE(guitars1->size() == guitars2->size());
+
+    BOOST_TEST_MESSAGE("Change IGuitar default bind to Ibanez : the plan must be outdated");
+    xpcfComponentManager->getFactory()->bind(xpcf::toUUID<IGuitar>(),
+                                             xpcf::toUUID("{ED894181-0FDC-4326-A068-CB2A5899CB13}"),
+                                             xpcf::BindingScope::Transient,
+                                             xpcf::BindingRange::All);
+    SRef<IGuitar> guitar3 = xpcfComponentManager->resolve<IGuitar>();
+    BOOST_TEST_REQUIRE(guitar3->getGuitarBrand() == "Ibanez", "resolved guitar brand after bind:" << guitar3->getGuitarBrand());
+    xpcfComponentManager->clear();
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 
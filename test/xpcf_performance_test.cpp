@@ -0,0 +1,1505 @@
+/**
+ * @copyright Copyright (c) 2017 B-com http://www.b-com.com/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Loïc Touraine
+ *
+ * @file
+ * @brief micro-benchmarks of the factory resolution
+ * @date 2026-10-17
+ */
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/detail/utf8_codecvt_facet.hpp>
+#include <boost/dll/runtime_symbol_info.hpp>
+#include <boost/dll/shared_library.hpp>
+#include <boost/fiber/future.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestDefines.h"
+#include <xpcf/component/ComponentBase.h>
+#include <xpcf/api/IModuleManager.h>
+#include <xpcf/api/IRegistryManager.h>
+#include <xpcf/module/ModuleFactory.h>
+
+namespace fs = boost::filesystem;
+
+// heap allocations counting : the replacement operators are used by the whole test application including xpcf
+static std::atomic<bool> countAllocations(false);
+static std::atomic<uint64_t> allocationsCount(0);
+
+void * operator new(std::size_t size)
+{
+    if (countAllocations) {
+        allocationsCount++;
+    }
+    void * ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace perftest {
+
+class ILeaf : virtual public xpcf::IComponentIntrospect {
+public:
+    ~ILeaf() override = default;
+    virtual int value() = 0;
+};
+
+class INode : virtual public xpcf::IComponentIntrospect {
+public:
+    ~INode() override = default;
+    virtual int sum() = 0;
+};
+
+}
+
+XPCF_DEFINE_INTERFACE_TRAITS(perftest::ILeaf, "9A1E0F43-6E8B-4F3C-A5E2-1F3A0C9B7D21", "ILeaf", "performance test leaf interface")
+XPCF_DEFINE_INTERFACE_TRAITS(perftest::INode, "4C7D2B18-93F0-4E6A-B1C5-7A2E6D0F8B34", "INode", "performance test node interface")
+
+namespace perftest {
+
+class Leaf : public xpcf::ComponentBase, virtual public ILeaf {
+public:
+    Leaf();
+    ~Leaf() override = default;
+    void unloadComponent() override final { delete this; }
+    int value() override { return 1; }
+};
+
+// counts its constructions : a singleton must be constructed once whatever the number of threads resolving it
+class CountedLeaf : public xpcf::ComponentBase, virtual public ILeaf {
+public:
+    CountedLeaf();
+    ~CountedLeaf() override { destructionsCount++; }
+    void unloadComponent() override final { delete this; }
+    int value() override { return 1; }
+
+    static std::atomic<uint32_t> constructionsCount;
+    static std::atomic<uint32_t> destructionsCount;
+};
+
+// slow to construct, like components loading resources upon creation
+class SlowLeaf : public xpcf::ComponentBase, virtual public ILeaf {
+public:
+    SlowLeaf();
+    ~SlowLeaf() override = default;
+    void unloadComponent() override final { delete this; }
+    int value() override { return 1; }
+};
+
+// counts its recycles and destructions
+class PooledLeaf : public xpcf::ComponentBase, virtual public ILeaf {
+public:
+    PooledLeaf();
+    ~PooledLeaf() override { destructionsCount++; }
+    void unloadComponent() override final { delete this; }
+    void onRecycled() override { recyclesCount++; m_value = 1; }
+    int value() override { return m_value++; }
+
+    static std::atomic<uint32_t> recyclesCount;
+    static std::atomic<uint32_t> destructionsCount;
+
+private:
+    int m_value = 1;
+};
+
+// Node depends on two leaves
+class Node : public xpcf::ComponentBase, virtual public INode {
+public:
+    Node();
+    ~Node() override = default;
+    void unloadComponent() override final { delete this; }
+    int sum() override { return m_left->value() + m_right->value(); }
+
+private:
+    SRef<ILeaf> m_left;
+    SRef<ILeaf> m_right;
+};
+
+// Fork depends on two nodes and checks they are both injected before onInjected is called
+class Fork : public xpcf::ComponentBase, virtual public INode {
+public:
+    Fork();
+    ~Fork() override = default;
+    void unloadComponent() override final { delete this; }
+    void onInjected() override { m_injected = m_left && m_right; }
+    int sum() override { return m_injected ? m_left->sum() + m_right->sum() : 0; }
+
+private:
+    SRef<INode> m_left;
+    SRef<INode> m_right;
+    bool m_injected = false;
+};
+
+// OptionalNode sums its leaf and the optional extra leaves injected
+class OptionalNode : public xpcf::ComponentBase, virtual public INode {
+public:
+    OptionalNode();
+    ~OptionalNode() override = default;
+    void unloadComponent() override final { delete this; }
+    int sum() override;
+
+private:
+    SRef<ILeaf> m_leaf;
+    std::array<SRef<ILeaf>, 4> m_extras;
+};
+
+// LazyNode only resolves its leaves when they are used
+class LazyNode : public xpcf::ComponentBase, virtual public INode {
+public:
+    LazyNode();
+    ~LazyNode() override = default;
+    void unloadComponent() override final { delete this; }
+    int sum() override { return m_leaf->value(); }
+    xpcf::Lazy<ILeaf> & leaf() { return m_leaf; }
+    xpcf::Lazy<INode> & fallback() { return m_fallback; }
+
+private:
+    xpcf::Lazy<ILeaf> m_leaf;
+    xpcf::Lazy<INode> m_fallback;
+};
+
+}
+
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::Leaf, "E3B6A0D2-58C1-4F97-8A4D-2C6B1E0F9A53", "Leaf", "performance test leaf component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::CountedLeaf, "B5D0E7A9-2F64-4C18-9A3B-8E1C6F2D4A70", "CountedLeaf", "performance test counted leaf component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::Fork, "2D9C4E81-7B3A-4F05-86E2-C1A5F0B93D46", "Fork", "performance test fork component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::LazyNode, "8E47B2C0-D91F-4A63-B5E8-3F06A9C1D752", "LazyNode", "performance test lazy node component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::OptionalNode, "C6E2A9F4-1B37-4D80-A5C9-7F3E0D2B8A16", "OptionalNode", "performance test optional injectables node component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::PooledLeaf, "F1A83C6D-4E92-4B07-9D5A-60C2E8B71F39", "PooledLeaf", "performance test pooled leaf component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::SlowLeaf, "5B0E9D72-C3A8-4F16-8D4B-E7A2906C1F35", "SlowLeaf", "performance test slow leaf component")
+XPCF_DEFINE_COMPONENT_TRAITS(perftest::Node, "71F4C9E5-0A2D-4B86-9E3F-5D8A1B7C6E02", "Node", "performance test node component")
+
+namespace perftest {
+
+Leaf::Leaf():ComponentBase(xpcf::toUUID<Leaf>())
+{
+    declareInterface<ILeaf>(this);
+}
+
+std::atomic<uint32_t> CountedLeaf::constructionsCount(0);
+std::atomic<uint32_t> CountedLeaf::destructionsCount(0);
+
+CountedLeaf::CountedLeaf():ComponentBase(xpcf::toUUID<CountedLeaf>())
+{
+    constructionsCount++;
+    // widen the race window between concurrent resolutions
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    declareInterface<ILeaf>(this);
+}
+
+SlowLeaf::SlowLeaf():ComponentBase(xpcf::toUUID<SlowLeaf>())
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    declareInterface<ILeaf>(this);
+}
+
+std::atomic<uint32_t> PooledLeaf::recyclesCount(0);
+std::atomic<uint32_t> PooledLeaf::destructionsCount(0);
+
+PooledLeaf::PooledLeaf():ComponentBase(xpcf::toUUID<PooledLeaf>())
+{
+    declareInterface<ILeaf>(this);
+}
+
+Node::Node():ComponentBase(xpcf::toUUID<Node>())
+{
+    declareInterface<INode>(this);
+    declareInjectable<ILeaf>(m_left);
+    declareInjectable<ILeaf>(m_right, "right");
+}
+
+LazyNode::LazyNode():ComponentBase(xpcf::toUUID<LazyNode>())
+{
+    declareInterface<INode>(this);
+    declareLazyInjectable<ILeaf>(m_leaf);
+    declareLazyInjectable<INode>(m_fallback, true);
+}
+
+OptionalNode::OptionalNode():ComponentBase(xpcf::toUUID<OptionalNode>())
+{
+    declareInterface<INode>(this);
+    declareInjectable<ILeaf>(m_leaf, "leaf");
+    declareInjectable<ILeaf>(m_extras[0], "extra0", true);
+    declareInjectable<ILeaf>(m_extras[1], "extra1", true);
+    declareInjectable<ILeaf>(m_extras[2], "extra2", true);
+    declareInjectable<ILeaf>(m_extras[3], "extra3", true);
+}
+
+int OptionalNode::sum()
+{
+    int sum = m_leaf->value();
+    for (auto & extra : m_extras) {
+        if (extra) {
+            sum += extra->value();
+        }
+    }
+    return sum;
+}
+
+Fork::Fork():ComponentBase(xpcf::toUUID<Fork>())
+{
+    declareInterface<INode>(this);
+    declareInjectable<INode>(m_left, "left");
+    declareInjectable<INode>(m_right, "right");
+}
+
+}
+
+namespace {
+
+constexpr uint32_t benchmarkIterations = 2000;
+
+// returns the mean duration of one call to func in microseconds
+double measure(const std::function<void(void)> & func, uint32_t iterations = benchmarkIterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        func();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// runs func from threadsCount threads started together and returns the elapsed time in microseconds
+double runConcurrently(uint32_t threadsCount, const std::function<void(uint32_t)> & func)
+{
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < threadsCount; i++) {
+        threads.emplace_back([&start, &func, i]() {
+            while (!start) {
+                std::this_thread::yield();
+            }
+            func(i);
+        });
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    start = true;
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsed.count();
+}
+
+uint32_t maxThreadsCount()
+{
+    return std::max(4u, std::thread::hardware_concurrency());
+}
+
+}
+
+// the test cases bind their components in an empty factory context : their binds don't leak into the other test cases
+struct LocalFactoryFixture : public XpcfFixture {
+    LocalFactoryFixture() { factory = xpcfComponentManager->getFactory()->createNewFactoryContext(xpcf::ContextMode::Empty); }
+
+    SRef<xpcf::IFactory> factory;
+};
+
+BOOST_AUTO_TEST_SUITE( test_performance )
+
+BOOST_FIXTURE_TEST_CASE( test_resolution_plan_benchmark,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+    SRef<xpcf::IFactory> factory = xpcfComponentManager->getFactory();
+    // the guitarist graph is rebuilt upon each resolution
+    auto bindGuitarist = [factory]() {
+        factory->bind(xpcf::toUUID<IGuitarist>(), xpcf::toUUID("63ff193d-93e6-4ede-9947-22f864ac843f"),
+                      xpcf::BindingScope::Transient, xpcf::BindingRange::All);
+    };
+    bindGuitarist();
+
+    // each bind outdates the resolution plans : every resolution is a cold one
+    double coldGuitarist = measure([&]() {
+        bindGuitarist();
+        factory->resolve<IGuitarist>();
+    });
+    double cachedGuitarist = measure([&]() { factory->resolve<IGuitarist>(); });
+    double coldMusician = measure([&]() {
+        bindGuitarist();
+        factory->resolve<IMusician>();
+    });
+    double cachedMusician = measure([&]() { factory->resolve<IMusician>(); });
+
+    BOOST_TEST_MESSAGE("IGuitarist resolution: cold=" << coldGuitarist << "us cached plan=" << cachedGuitarist << "us");
+    BOOST_TEST_MESSAGE("IMusician resolution: cold=" << coldMusician << "us cached plan=" << cachedMusician << "us");
+    BOOST_TEST_WARN(cachedGuitarist < coldGuitarist);
+
+    // the cached plan resolves the bound component, and the transient scope still creates a new instance upon each resolution
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<IGuitarist>()) == xpcf::toUUID("63ff193d-93e6-4ede-9947-22f864ac843f"));
+    SRef<IGuitarist> guitarist = factory->resolve<IGuitarist>();
+    BOOST_TEST_REQUIRE(guitarist);
+    BOOST_TEST_CHECK(factory->resolve<IGuitarist>() != guitarist);
+    guitarist.reset();
+    xpcfComponentManager->clear();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_resolution_allocations,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    xpcf::uuids::uuid nodeUUID = xpcf::toUUID<perftest::INode>();
+    xpcf::uuids::uuid leafUUID = xpcf::toUUID<perftest::ILeaf>();
+
+    // record the resolution plan
+    BOOST_TEST_REQUIRE(factory->resolve(nodeUUID)->bindTo<perftest::INode>()->sum() == 2);
+
+    // allocations needed to create and wire the components by hand
+    allocationsCount = 0;
+    countAllocations = true;
+    {
+        SRef<xpcf::IComponentIntrospect> node = xpcf::ComponentFactory::create<perftest::Node>();
+        SRef<xpcf::IComponentIntrospect> left = xpcf::ComponentFactory::create<perftest::Leaf>();
+        SRef<xpcf::IComponentIntrospect> right = xpcf::ComponentFactory::create<perftest::Leaf>();
+        SRef<xpcf::IInjectable> injectable = node->bindTo<xpcf::IInjectable>();
+        for (auto injector : injectable->getInjectables()) {
+            injector->inject(*injectable, injector->isNamed() ? right : left);
+        }
+        injectable->onInjected();
+        for (auto & leaf : {left, right}) {
+            SRef<xpcf::IInjectable> leafInjectable = leaf->bindTo<xpcf::IInjectable>();
+            for (auto injector : leafInjectable->getInjectables()) {
+                (void)injector;
+            }
+            leafInjectable->onInjected();
+        }
+    }
+    countAllocations = false;
+    uint64_t componentsAllocations = allocationsCount;
+
+    allocationsCount = 0;
+    countAllocations = true;
+    {
+        SRef<xpcf::IComponentIntrospect> node = factory->resolve(nodeUUID);
+    }
+    countAllocations = false;
+    uint64_t resolutionAllocations = allocationsCount;
+
+    BOOST_TEST_MESSAGE("Heap allocations: components=" << componentsAllocations << " resolution=" << resolutionAllocations);
+    BOOST_TEST_CHECK(resolutionAllocations == componentsAllocations, "a cached plan resolution must not allocate beyond the components");
+    BOOST_TEST_CHECK(factory->resolve(leafUUID)->bindTo<perftest::ILeaf>()->value() == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_concurrent_singleton_resolution,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::Singleton>();
+    perftest::CountedLeaf::constructionsCount = 0;
+    uint32_t threadsCount = maxThreadsCount() * 2;
+    std::vector<SRef<perftest::ILeaf>> leaves(threadsCount);
+    runConcurrently(threadsCount, [&](uint32_t index) {
+        leaves[index] = factory->resolve<perftest::ILeaf>();
+    });
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+    for (auto & leaf : leaves) {
+        BOOST_TEST_CHECK(leaf == leaves.front());
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( test_concurrent_resolution,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    constexpr uint32_t resolutionsPerThread = 5000;
+
+    // resolutions scaling
+    double singleThreadThroughput = 0;
+    for (uint32_t threadsCount = 1; threadsCount <= maxThreadsCount(); threadsCount *= 2) {
+        std::atomic<uint32_t> failures(0);
+        double elapsed = runConcurrently(threadsCount, [&](uint32_t) {
+            for (uint32_t i = 0; i < resolutionsPerThread; i++) {
+                if (factory->resolve<perftest::INode>()->sum() != 2) {
+                    failures++;
+                }
+            }
+        });
+        double throughput = threadsCount * resolutionsPerThread / elapsed;
+        if (threadsCount == 1) {
+            singleThreadThroughput = throughput;
+        }
+        BOOST_TEST_MESSAGE("INode resolution with " << threadsCount << " threads: " << throughput << " resolutions/us scaling="
+                           << throughput / singleThreadThroughput);
+        BOOST_TEST_CHECK(failures == 0);
+    }
+
+    // resolutions while another thread updates the bindings
+    std::atomic<bool> resolving(true);
+    std::atomic<uint32_t> failures(0);
+    std::thread binder([&]() {
+        while (resolving) {
+            factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+        }
+    });
+    runConcurrently(maxThreadsCount(), [&](uint32_t) {
+        for (uint32_t i = 0; i < resolutionsPerThread / 10; i++) {
+            if (factory->resolve<perftest::INode>()->sum() != 2) {
+                failures++;
+            }
+        }
+    });
+    resolving = false;
+    binder.join();
+    BOOST_TEST_CHECK(failures == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_parallel_injection,LocalFactoryFixture )
+{
+    // a fork of two nodes, each node injects two leaves taking 1ms to construct
+    factory->bindLocal<perftest::INode, perftest::Fork>();
+    factory->bindLocal<perftest::INode, perftest::Node>("left");
+    factory->bindLocal<perftest::INode, perftest::Node>("right");
+    auto bindLeaves = [this]() {
+        factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf>();
+        factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf>("right");
+    };
+    bindLeaves();
+    constexpr uint32_t iterations = 50;
+
+    BOOST_TEST_REQUIRE(!factory->parallelInjectionEnabled());
+    double coldSequential = measure([&]() {
+        bindLeaves();
+        BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 4);
+    }, iterations);
+    double cachedSequential = measure([&]() { factory->resolve<perftest::INode>(); }, iterations);
+
+    factory->enableParallelInjection(true);
+    BOOST_TEST_CHECK(factory->createNewFactoryContext(xpcf::ContextMode::Cloned)->parallelInjectionEnabled());
+    perftest::CountedLeaf::constructionsCount = 0;
+    double coldParallel = measure([&]() {
+        bindLeaves();
+        BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 4);
+    }, iterations);
+    double cachedParallel = measure([&]() {
+        BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 4);
+    }, iterations);
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 2 * 4 * iterations);
+
+    BOOST_TEST_MESSAGE("Fork resolution sequential: cold=" << coldSequential << "us cached plan=" << cachedSequential << "us");
+    BOOST_TEST_MESSAGE("Fork resolution parallel: cold=" << coldParallel << "us cached plan=" << cachedParallel << "us");
+    BOOST_TEST_WARN(coldParallel < coldSequential);
+    BOOST_TEST_WARN(cachedParallel < cachedSequential);
+
+    // a missing mandatory injectable fails the parallel injection as the sequential one
+    SRef<xpcf::IFactory> incompleteFactory = factory->createNewFactoryContext(xpcf::ContextMode::Empty);
+    incompleteFactory->enableParallelInjection(true);
+    incompleteFactory->bindLocal<perftest::INode, perftest::Node>();
+    BOOST_CHECK_THROW(incompleteFactory->resolve<perftest::INode>(), xpcf::ConfigurationException);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_lazy_injection,LocalFactoryFixture )
+{
+    // no default INode bind : the optional fallback isn't injected
+    factory->bindLocal<perftest::INode, perftest::LazyNode, xpcf::BindingScope::Transient,
+                       xpcf::BindingRange::Named|xpcf::BindingRange::Default>("lazy");
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf>();
+    perftest::CountedLeaf::constructionsCount = 0;
+
+    SRef<perftest::LazyNode> node = xpcf::utils::dynamic_pointer_cast<perftest::LazyNode>(factory->resolve<perftest::INode>("lazy"));
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 0);
+    BOOST_TEST_CHECK(static_cast<bool>(node->leaf()));
+    BOOST_TEST_CHECK(!node->leaf().resolved());
+    BOOST_TEST_CHECK(!node->fallback());
+    BOOST_CHECK_THROW(node->fallback().get(), xpcf::InjectableNotFoundException);
+
+    // concurrent first uses resolve the leaf once
+    std::vector<SRef<perftest::ILeaf>> leaves(maxThreadsCount());
+    runConcurrently(maxThreadsCount(), [&](uint32_t index) {
+        leaves[index] = node->leaf().get();
+    });
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+    for (auto & leaf : leaves) {
+        BOOST_TEST_CHECK(leaf == leaves.front());
+    }
+    BOOST_TEST_CHECK(node->sum() == 1);
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+
+    // the lazy resolution uses the component context levels of the injection
+    factory->bindLocal<perftest::LazyNode, perftest::ILeaf, perftest::Leaf>();
+    node = xpcf::utils::dynamic_pointer_cast<perftest::LazyNode>(factory->resolve<perftest::INode>("lazy"));
+    // bindings changed after injection don't apply to the lazy handle
+    factory->bindLocal<perftest::LazyNode, perftest::ILeaf, perftest::CountedLeaf>();
+    BOOST_TEST_CHECK(node->sum() == 1);
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+
+    // replayed plans inject lazy handles too
+    for (uint32_t i = 0; i < 3; i++) {
+        node = xpcf::utils::dynamic_pointer_cast<perftest::LazyNode>(factory->resolve<perftest::INode>("lazy"));
+        BOOST_TEST_CHECK(!node->leaf().resolved());
+        BOOST_TEST_CHECK(node->sum() == 1);
+    }
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 4);
+
+    // a missing mandatory lazy injectable fails the injection
+    SRef<xpcf::IFactory> incompleteFactory = factory->createNewFactoryContext(xpcf::ContextMode::Empty);
+    incompleteFactory->bindLocal<perftest::INode, perftest::LazyNode>();
+    BOOST_CHECK_THROW(incompleteFactory->resolve<perftest::INode>(), xpcf::ConfigurationException);
+
+    // the lazy handle doesn't keep its factory alive : its resolution fails once the factory is destroyed
+    SRef<xpcf::IFactory> transientFactory = factory->createNewFactoryContext(xpcf::ContextMode::Empty);
+    transientFactory->bindLocal<perftest::INode, perftest::LazyNode>();
+    transientFactory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    node = xpcf::utils::dynamic_pointer_cast<perftest::LazyNode>(transientFactory->resolve<perftest::INode>());
+    transientFactory.reset();
+    BOOST_CHECK_THROW(node->leaf().get(), xpcf::ConfigurationException);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_pooled_scope,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::ILeaf, perftest::PooledLeaf, xpcf::BindingScope::Pooled>();
+    perftest::PooledLeaf::recyclesCount = 0;
+    perftest::PooledLeaf::destructionsCount = 0;
+
+    SRef<perftest::ILeaf> leaf = factory->resolve<perftest::ILeaf>();
+    BOOST_TEST_CHECK(leaf->value() == 1);
+    BOOST_TEST_CHECK(leaf->value() == 2);
+    perftest::ILeaf * leafAddress = leaf.get();
+    leaf.reset();
+    BOOST_TEST_CHECK(perftest::PooledLeaf::recyclesCount == 1);
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 0);
+
+    // the released instance is handed out again, reset
+    leaf = factory->resolve<perftest::ILeaf>();
+    BOOST_TEST_CHECK(leaf.get() == leafAddress);
+    BOOST_TEST_CHECK(leaf->value() == 1);
+    // instances in use are never shared
+    SRef<perftest::ILeaf> otherLeaf = factory->resolve<perftest::ILeaf>();
+    BOOST_TEST_CHECK(otherLeaf.get() != leaf.get());
+    leaf.reset();
+    otherLeaf.reset();
+
+    // the pool keeps at most poolSize idle instances
+    std::vector<SRef<perftest::ILeaf>> leaves;
+    for (uint32_t i = 0; i < 20; i++) {
+        leaves.push_back(factory->resolve<perftest::ILeaf>());
+    }
+    perftest::PooledLeaf::destructionsCount = 0;
+    leaves.clear();
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 4);
+
+    // pooled instances are unloaded with their pool when the bindings change
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->resolve<perftest::ILeaf>();
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 20);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_pooled_scope_benchmark,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+    SRef<xpcf::IFactory> factory = xpcfComponentManager->getFactory();
+    xpcf::uuids::uuid guitaristUUID = xpcf::toUUID("63ff193d-93e6-4ede-9947-22f864ac843f");
+
+    // module components : module lookup, creation, injection and xml configuration
+    factory->bind(xpcf::toUUID<IGuitarist>(), guitaristUUID, xpcf::BindingScope::Transient, xpcf::BindingRange::All);
+    double transientGuitarist = measure([&]() { factory->resolve<IGuitarist>(); });
+    factory->bind(xpcf::toUUID<IGuitarist>(), guitaristUUID, xpcf::BindingScope::Pooled, xpcf::BindingRange::All);
+    double pooledGuitarist = measure([&]() { factory->resolve<IGuitarist>(); });
+    BOOST_TEST_MESSAGE("IGuitarist resolution rate: transient=" << 1e6 / transientGuitarist << "/s pooled=" << 1e6 / pooledGuitarist << "/s");
+    BOOST_TEST_WARN(pooledGuitarist < transientGuitarist);
+    // the released guitarist returns to the pool and is reused by the next resolution
+    IGuitarist * guitaristAddress = factory->resolve<IGuitarist>().get();
+    BOOST_TEST_CHECK(factory->resolve<IGuitarist>().get() == guitaristAddress);
+
+    // in-code components
+    SRef<xpcf::IFactory> localFactory = factory->createNewFactoryContext(xpcf::ContextMode::Empty);
+    localFactory->bindLocal<perftest::INode, perftest::Node>();
+    localFactory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    localFactory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    double transientNode = measure([&]() { localFactory->resolve<perftest::INode>(); });
+    localFactory->bindLocal<perftest::INode, perftest::Node, xpcf::BindingScope::Pooled>();
+    double pooledNode = measure([&]() { localFactory->resolve<perftest::INode>(); });
+    BOOST_TEST_MESSAGE("INode resolution rate: transient=" << 1e6 / transientNode << "/s pooled=" << 1e6 / pooledNode << "/s");
+    BOOST_TEST_WARN(pooledNode < transientNode);
+    perftest::INode * nodeAddress = localFactory->resolve<perftest::INode>().get();
+    BOOST_TEST_CHECK(localFactory->resolve<perftest::INode>().get() == nodeAddress);
+    BOOST_TEST_CHECK(localFactory->resolve<perftest::INode>()->sum() == 2);
+
+    // the idle instances of a destroyed pool release their module
+    SRef<xpcf::IModuleManager> moduleManager = xpcf::getModuleManagerInstance();
+    xpcf::uuids::uuid moduleUUID = xpcfComponentManager->getModuleUUID(guitaristUUID);
+    uint32_t componentsCount = moduleManager->getComponentsCount(moduleUUID);
+    SRef<xpcf::IFactory> pooledFactory = factory->createNewFactoryContext(xpcf::ContextMode::Cloned);
+    pooledFactory->bind(xpcf::toUUID<IGuitarist>(), guitaristUUID, xpcf::BindingScope::Pooled, xpcf::BindingRange::All);
+    pooledFactory->resolve<IGuitarist>();
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleUUID) > componentsCount);
+    pooledFactory.reset();
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleUUID) == componentsCount);
+    xpcfComponentManager->clear();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_per_thread_scope,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::PerThread>();
+    perftest::CountedLeaf::constructionsCount = 0;
+
+    uint32_t threadsCount = maxThreadsCount();
+    std::vector<perftest::ILeaf *> leaves(threadsCount, nullptr);
+    std::atomic<uint32_t> mismatches(0);
+    runConcurrently(threadsCount, [&](uint32_t threadIndex) {
+        SRef<perftest::ILeaf> leaf = factory->resolve<perftest::ILeaf>();
+        for (uint32_t i = 0; i < 100; i++) {
+            if (factory->resolve<perftest::ILeaf>() != leaf) {
+                mismatches++;
+            }
+        }
+        leaves[threadIndex] = leaf.get();
+    });
+    BOOST_TEST_CHECK(mismatches == 0);
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == threadsCount);
+    std::sort(leaves.begin(), leaves.end());
+    BOOST_TEST_CHECK((std::unique(leaves.begin(), leaves.end()) == leaves.end()));
+
+    // a cleared factory hands out new per thread instances
+    SRef<perftest::ILeaf> leaf = factory->resolve<perftest::ILeaf>();
+    factory->clear();
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::PerThread>();
+    BOOST_TEST_CHECK(factory->resolve<perftest::ILeaf>() != leaf);
+    leaf.reset();
+
+    // clear and the factory destruction release the per thread instances of the running threads
+    SRef<xpcf::IFactory> otherFactory = factory->createNewFactoryContext(xpcf::ContextMode::Empty);
+    otherFactory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::PerThread>();
+    std::atomic<bool> resolved(false);
+    std::atomic<bool> checked(false);
+    std::thread worker([&]() {
+        factory->resolve<perftest::ILeaf>();
+        otherFactory->resolve<perftest::ILeaf>();
+        resolved = true;
+        while (!checked) {
+            std::this_thread::yield();
+        }
+    });
+    while (!resolved) {
+        std::this_thread::yield();
+    }
+    perftest::CountedLeaf::destructionsCount = 0;
+    factory->clear();
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 2);
+    otherFactory.reset();
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 3);
+    checked = true;
+    worker.join();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_scoped_scope,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::ILeaf, perftest::PooledLeaf, xpcf::BindingScope::Scoped>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf, xpcf::BindingScope::Singleton, xpcf::BindingRange::Named>("right");
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    perftest::PooledLeaf::destructionsCount = 0;
+
+    // outside a scope, scoped components are transient
+    BOOST_TEST_CHECK(factory->resolve<perftest::ILeaf>() != factory->resolve<perftest::ILeaf>());
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 2);
+    perftest::PooledLeaf::destructionsCount = 0;
+
+    SRef<xpcf::IFactory> scope = factory->createScope();
+    SRef<perftest::ILeaf> leaf = scope->resolve<perftest::ILeaf>();
+    BOOST_TEST_CHECK(scope->resolve<perftest::ILeaf>() == leaf);
+    // injections within the scope share the scoped instance
+    BOOST_TEST_CHECK(scope->resolve<perftest::INode>()->sum() == 2);
+    BOOST_TEST_CHECK(leaf->value() == 2);
+    // singletons are shared with the parent factory
+    BOOST_TEST_CHECK(scope->resolve<perftest::ILeaf>("right") == factory->resolve<perftest::ILeaf>("right"));
+
+    SRef<xpcf::IFactory> otherScope = factory->createScope();
+    BOOST_TEST_CHECK(otherScope->resolve<perftest::ILeaf>() != leaf);
+    SRef<xpcf::IFactory> nestedScope = scope->createScope();
+    BOOST_TEST_CHECK(nestedScope->resolve<perftest::ILeaf>() != leaf);
+    nestedScope.reset();
+    otherScope.reset();
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 2);
+
+    // the scoped instances are released with their scope
+    leaf.reset();
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 2);
+    scope.reset();
+    BOOST_TEST_CHECK(perftest::PooledLeaf::destructionsCount == 3);
+
+    // clearing a scope releases its scoped instances only : the bindings belong to the parent factory
+    scope = factory->createScope();
+    leaf = scope->resolve<perftest::ILeaf>();
+    scope->clear();
+    BOOST_TEST_CHECK(scope->resolve<perftest::ILeaf>() != leaf);
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<perftest::ILeaf>()) == xpcf::toUUID<perftest::PooledLeaf>());
+}
+
+BOOST_FIXTURE_TEST_CASE( test_scoped_scope_benchmark,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    constexpr uint32_t resolutionsPerRequest = 16;
+    // a request handler resolves the same sub-graph several times within a request
+    auto handleRequest = [&]() {
+        SRef<xpcf::IFactory> scope = factory->createScope();
+        for (uint32_t i = 0; i < resolutionsPerRequest; i++) {
+            scope->resolve<perftest::INode>();
+        }
+    };
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    double transient = measure(handleRequest, 200);
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf, xpcf::BindingScope::Scoped>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf, xpcf::BindingScope::Scoped, xpcf::BindingRange::Named>("right");
+    double scoped = measure(handleRequest, 200);
+    // the scoped leaves are shared within a request and renewed by the next one
+    SRef<xpcf::IFactory> request = factory->createScope();
+    SRef<perftest::ILeaf> requestLeaf = request->resolve<perftest::ILeaf>();
+    BOOST_TEST_CHECK(request->resolve<perftest::ILeaf>() == requestLeaf);
+    BOOST_TEST_CHECK(factory->createScope()->resolve<perftest::ILeaf>() != requestLeaf);
+    BOOST_TEST_CHECK(request->resolve<perftest::INode>()->sum() == 2);
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf, xpcf::BindingScope::PerThread>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf, xpcf::BindingScope::PerThread, xpcf::BindingRange::Named>("right");
+    double perThread = measure(handleRequest, 200);
+    double scopeCreation = measure([&]() { factory->createScope(); });
+    BOOST_TEST_MESSAGE("Request handling (" << resolutionsPerRequest << " INode resolutions): transient leaves=" << transient
+                       << "us scoped leaves=" << scoped << "us per thread leaves=" << perThread << "us");
+    BOOST_TEST_MESSAGE("Scope creation: " << scopeCreation << "us");
+    BOOST_TEST_WARN(scoped < transient);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_frozen_bindings,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Fork>();
+    factory->bindLocal<perftest::INode, perftest::Node>("left");
+    factory->bindLocal<perftest::INode, perftest::Node>("right");
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    factory->bindLocal<perftest::Node, perftest::ILeaf, perftest::PooledLeaf>();
+    BOOST_TEST_CHECK(!factory->frozen());
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 4);
+
+    factory->freeze();
+    BOOST_TEST_CHECK(factory->frozen());
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<perftest::INode>()) == xpcf::toUUID<perftest::Fork>());
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<perftest::INode>(), "left") == xpcf::toUUID<perftest::Node>());
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 4);
+    BOOST_CHECK_THROW(factory->getComponentUUID(xpcf::toUUID<IGuitarist>()), xpcf::InjectableNotFoundException);
+
+    // binds declared after freeze compile the tables again
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf>("right");
+    BOOST_TEST_CHECK(factory->frozen());
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<perftest::ILeaf>(), "right") == xpcf::toUUID<perftest::CountedLeaf>());
+}
+
+BOOST_FIXTURE_TEST_CASE( test_frozen_bindings_benchmark,LocalFactoryFixture )
+{
+    xpcf::uuids::random_generator generator;
+    std::vector<xpcf::uuids::uuid> interfaces;
+    for (uint32_t i = 0; i < 512; i++) {
+        interfaces.push_back(generator());
+        factory->bind(interfaces.back(), xpcf::toUUID<perftest::Leaf>(), xpcf::BindingScope::Transient, xpcf::BindingRange::All);
+        factory->bind("named", interfaces.back(), xpcf::toUUID<perftest::Leaf>(), xpcf::BindingScope::Transient, xpcf::BindingRange::Named);
+    }
+    constexpr uint32_t iterations = 200;
+    auto lookup = [&]() {
+        for (auto & interfaceUUID : interfaces) {
+            factory->getComponentUUID(interfaceUUID);
+        }
+    };
+    auto namedLookup = [&]() {
+        for (auto & interfaceUUID : interfaces) {
+            factory->getComponentUUID(interfaceUUID, "named");
+        }
+    };
+    double mapLookup = measure(lookup, iterations) / interfaces.size();
+    double mapNamedLookup = measure(namedLookup, iterations) / interfaces.size();
+    factory->freeze();
+    double frozenLookup = measure(lookup, iterations) / interfaces.size();
+    double frozenNamedLookup = measure(namedLookup, iterations) / interfaces.size();
+    // the frozen tables resolve every bind as the maps did
+    uint32_t mismatches = 0;
+    for (auto & interfaceUUID : interfaces) {
+        if (factory->getComponentUUID(interfaceUUID) != xpcf::toUUID<perftest::Leaf>()
+                || factory->getComponentUUID(interfaceUUID, "named") != xpcf::toUUID<perftest::Leaf>()) {
+            mismatches++;
+        }
+    }
+    BOOST_TEST_CHECK(mismatches == 0);
+    BOOST_TEST_MESSAGE("Bind lookup among " << interfaces.size() << " binds: maps=" << mapLookup * 1000 << "ns frozen=" << frozenLookup * 1000 << "ns");
+    BOOST_TEST_MESSAGE("Named bind lookup among " << interfaces.size() << " binds: maps=" << mapNamedLookup * 1000 << "ns frozen=" << frozenNamedLookup * 1000 << "ns");
+    BOOST_TEST_WARN(frozenLookup < mapLookup);
+    BOOST_TEST_WARN(frozenNamedLookup < mapNamedLookup);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_async_resolution,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::Singleton>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    perftest::CountedLeaf::constructionsCount = 0;
+
+    // concurrent asynchronous resolutions create the singleton once
+    std::vector<std::future<SRef<perftest::ILeaf>>> leaves;
+    for (uint32_t i = 0; i < 16; i++) {
+        leaves.push_back(factory->resolveAsync<perftest::ILeaf>());
+    }
+    SRef<perftest::ILeaf> leaf = leaves.front().get();
+    for (uint32_t i = 1; i < leaves.size(); i++) {
+        BOOST_TEST_CHECK(leaves[i].get() == leaf);
+    }
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+
+    BOOST_TEST_CHECK(factory->resolveAsync<perftest::INode>().get()->sum() == 2);
+    BOOST_TEST_CHECK(factory->resolveAsync<perftest::ILeaf>("right").get()->value() == 1);
+    BOOST_TEST_CHECK(factory->resolveAllAsync<perftest::INode>().get()->size() == 1);
+    // fiber futures
+    boost::fibers::future<SRef<perftest::INode>> fiberNode = factory->resolveAsync<perftest::INode, boost::fibers::promise>();
+    BOOST_TEST_CHECK(fiberNode.get()->sum() == 2);
+    // resolution errors are rethrown by the future
+    SRef<xpcf::IFactory> emptyFactory = factory->createNewFactoryContext(xpcf::ContextMode::Empty);
+    std::future<SRef<perftest::INode>> missingNode = emptyFactory->resolveAsync<perftest::INode>();
+    BOOST_CHECK_THROW(missingNode.get(), xpcf::Exception);
+
+    // resolutions run with the executor set
+    std::vector<std::function<void(void)>> tasks;
+    factory->setAsyncExecutor([&tasks](const std::function<void(void)> & task) { tasks.push_back(task); });
+    std::future<SRef<perftest::INode>> node = factory->resolveAsync<perftest::INode>();
+    BOOST_TEST_CHECK((node.wait_for(std::chrono::seconds(0)) == std::future_status::timeout));
+    BOOST_TEST_CHECK(tasks.size() == 1);
+    for (auto & task : tasks) {
+        task();
+    }
+    BOOST_TEST_CHECK(node.get()->sum() == 2);
+    factory->setAsyncExecutor(nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_singleton_warmup,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node, xpcf::BindingScope::Singleton>();
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::Singleton>();
+    factory->bindLocal<perftest::ILeaf, perftest::SlowLeaf, xpcf::BindingScope::Singleton>("right");
+    // transient binds are not instantiated
+    factory->bindLocal<perftest::INode, perftest::Fork>("fork");
+    constexpr uint32_t slowSingletonsCount = 8;
+    for (uint32_t i = 0; i < slowSingletonsCount; i++) {
+        factory->bind("slow" + std::to_string(i), xpcf::toUUID<perftest::ILeaf>(), xpcf::toUUID<perftest::SlowLeaf>(),
+                      &xpcf::ComponentFactory::create<perftest::SlowLeaf>, xpcf::BindingScope::Singleton, xpcf::BindingRange::Named);
+    }
+    perftest::CountedLeaf::constructionsCount = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<xpcf::SingletonWarmupInfos> report = factory->warmup();
+    std::chrono::duration<double, std::micro> warmupDuration = std::chrono::steady_clock::now() - start;
+    BOOST_TEST_CHECK(report.size() == slowSingletonsCount + 3);
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+    double constructionsDuration = 0;
+    for (auto & infos : report) {
+        if (infos.componentUUID == xpcf::toUUID<perftest::SlowLeaf>()) {
+            BOOST_TEST_CHECK(infos.duration.count() >= 10000);
+            constructionsDuration += infos.duration.count();
+        }
+    }
+
+    // resolutions return the singletons created upon warmup
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 2);
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+    BOOST_TEST_MESSAGE("Warmup of " << report.size() << " singletons: " << warmupDuration.count() << "us for "
+                       << constructionsDuration << "us of slow singletons constructions");
+    BOOST_TEST_WARN(warmupDuration.count() < constructionsDuration);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_overlay_context,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    SRef<xpcf::IFactory> overlay = factory->createNewFactoryContext(xpcf::ContextMode::Overlay);
+    // the overlay resolves through its parent binds
+    BOOST_TEST_CHECK(overlay->resolve<perftest::INode>()->sum() == 2);
+    BOOST_TEST_CHECK(overlay->getComponentUUID(xpcf::toUUID<perftest::ILeaf>(), "right") == xpcf::toUUID<perftest::Leaf>());
+
+    // overlay binds override the parent binds without modifying them
+    overlay->bindLocal<perftest::INode, perftest::Fork>();
+    overlay->bindLocal<perftest::INode, perftest::Node>("left");
+    overlay->bindLocal<perftest::INode, perftest::Node>("right");
+    BOOST_TEST_CHECK(overlay->getComponentUUID(xpcf::toUUID<perftest::INode>()) == xpcf::toUUID<perftest::Fork>());
+    BOOST_TEST_CHECK(overlay->resolve<perftest::INode>()->sum() == 4);
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<perftest::INode>()) == xpcf::toUUID<perftest::Node>());
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 2);
+
+    // binds added to the parent after the overlay creation are visible from the overlay
+    factory->bindLocal<perftest::Node, perftest::ILeaf, perftest::CountedLeaf>();
+    perftest::CountedLeaf::constructionsCount = 0;
+    overlay->resolve<perftest::INode>("left");
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+
+    // clearing the overlay keeps its parent binds
+    overlay->clear();
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 2);
+    BOOST_TEST_CHECK(overlay->getComponentUUID(xpcf::toUUID<perftest::INode>()) == xpcf::toUUID<perftest::Node>());
+}
+
+BOOST_AUTO_TEST_CASE( test_overlay_context_benchmark )
+{
+    SRef<xpcf::IFactory> factory = xpcf::getComponentManagerInstance()->getFactory()->createNewFactoryContext(xpcf::ContextMode::Cloned);
+    xpcf::uuids::random_generator generator;
+    for (uint32_t i = 0; i < 512; i++) {
+        factory->bind(generator(), xpcf::toUUID<perftest::Leaf>(), xpcf::BindingScope::Transient, xpcf::BindingRange::All);
+    }
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    constexpr uint32_t iterations = 200;
+    double cloned = measure([&]() { factory->createNewFactoryContext(xpcf::ContextMode::Cloned); }, iterations);
+    double overlay = measure([&]() { factory->createNewFactoryContext(xpcf::ContextMode::Overlay); }, iterations);
+    SRef<xpcf::IFactory> child = factory->createNewFactoryContext(xpcf::ContextMode::Overlay);
+    child->bindLocal<perftest::ILeaf, perftest::CountedLeaf>("left");
+    double parentResolution = measure([&]() { factory->resolve<perftest::INode>(); }, 10000);
+    double overlayResolution = measure([&]() { child->resolve<perftest::INode>(); }, 10000);
+    // the overlay resolves the parent binds, and its own binds don't reach the parent
+    BOOST_TEST_CHECK(child->resolve<perftest::INode>()->sum() == 2);
+    BOOST_TEST_CHECK(child->getComponentUUID(xpcf::toUUID<perftest::ILeaf>(), "left") == xpcf::toUUID<perftest::CountedLeaf>());
+    BOOST_TEST_CHECK(factory->getComponentUUID(xpcf::toUUID<perftest::ILeaf>(), "left") == xpcf::toUUID<perftest::Leaf>());
+    BOOST_TEST_MESSAGE("Child context creation: cloned=" << cloned << "us overlay=" << overlay << "us");
+    BOOST_TEST_MESSAGE("INode resolution: parent=" << parentResolution << "us overlay=" << overlayResolution << "us");
+    BOOST_TEST_WARN(overlay < cloned);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_batch_resolution,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::CountedLeaf, xpcf::BindingScope::Singleton, xpcf::BindingRange::Named>("right");
+    perftest::CountedLeaf::constructionsCount = 0;
+    auto [node, leaf] = factory->resolveMany<perftest::INode, perftest::ILeaf>();
+    BOOST_TEST_CHECK(node->sum() == 2);
+    BOOST_TEST_CHECK(leaf->value() == 1);
+
+    // a failed resolution doesn't abort the batch, and a singleton is resolved once
+    for (bool parallel : {false, true}) {
+        std::vector<xpcf::BatchResolution> batch = factory->resolveMany({{xpcf::toUUID<perftest::INode>(), ""},
+                                                                         {xpcf::toUUID<IGuitarist>(), ""},
+                                                                         {xpcf::toUUID<perftest::ILeaf>(), "right"},
+                                                                         {xpcf::toUUID<perftest::ILeaf>(), "right"}}, parallel);
+        BOOST_REQUIRE(batch.size() == 4);
+        BOOST_TEST_CHECK(batch[0].component);
+        BOOST_TEST_CHECK(!batch[0].error);
+        BOOST_TEST_CHECK(!batch[1].component);
+        BOOST_CHECK_THROW(std::rethrow_exception(batch[1].error), xpcf::Exception);
+        BOOST_TEST_CHECK(batch[2].component == batch[3].component);
+    }
+    BOOST_TEST_CHECK(perftest::CountedLeaf::constructionsCount == 1);
+    BOOST_CHECK_THROW((factory->resolveMany<perftest::INode, IGuitarist>()), xpcf::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_batch_resolution_benchmark,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    factory->bindLocal<perftest::INode, perftest::Fork>();
+    factory->bindLocal<perftest::INode, perftest::Node>("left");
+    factory->bindLocal<perftest::INode, perftest::Node>("right");
+    factory->bindLocal<perftest::ILeaf, perftest::SlowLeaf>("slow");
+    std::vector<std::pair<xpcf::uuids::uuid,std::string>> requests = {{xpcf::toUUID<perftest::INode>(), ""},
+                                                                      {xpcf::toUUID<perftest::ILeaf>(), ""},
+                                                                      {xpcf::toUUID<perftest::ILeaf>(), "right"}};
+    for (uint32_t i = 0; i < 4; i++) {
+        requests.push_back({xpcf::toUUID<perftest::ILeaf>(), "slow"});
+    }
+    constexpr uint32_t iterations = 20;
+    double sequential = measure([&]() {
+        for (auto & [interfaceUUID, name] : requests) {
+            factory->resolve(interfaceUUID, name);
+        }
+    }, iterations);
+    double batch = measure([&]() { factory->resolveMany(requests); }, iterations);
+    double parallelBatch = measure([&]() { factory->resolveMany(requests, true); }, iterations);
+    // the parallel batch resolves every request in the order of the requests
+    std::vector<xpcf::BatchResolution> resolutions = factory->resolveMany(requests, true);
+    BOOST_TEST_REQUIRE(resolutions.size() == requests.size());
+    for (std::size_t i = 0; i < requests.size(); i++) {
+        BOOST_TEST_CHECK(resolutions[i].component);
+        BOOST_TEST_CHECK(!resolutions[i].error);
+        BOOST_TEST_CHECK(resolutions[i].name == requests[i].second);
+    }
+    BOOST_TEST_MESSAGE("Bootstrap of " << requests.size() << " components: successive resolutions=" << sequential
+                       << "us batch=" << batch << "us parallel batch=" << parallelBatch << "us");
+    BOOST_TEST_WARN(parallelBatch < sequential);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_try_resolve,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::OptionalNode>();
+    // no default ILeaf bind : named lookups would fall back to it
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("leaf");
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("extra2");
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 2);
+
+    xpcf::result<SRef<perftest::INode>, xpcf::XPCFErrorCode> node = factory->tryResolve<perftest::INode>();
+    BOOST_TEST_CHECK(!node.hasError());
+    BOOST_TEST_CHECK(node.getValue()->sum() == 2);
+    xpcf::result<SRef<IGuitarist>, xpcf::XPCFErrorCode> guitarist = factory->tryResolve<IGuitarist>();
+    BOOST_TEST_CHECK(guitarist.hasError());
+    BOOST_TEST_CHECK((guitarist.errCode() == xpcf::XPCFErrorCode::_ERROR_INJECTABLE_NOBIND));
+    BOOST_TEST_CHECK(!guitarist.getValue());
+    xpcf::result<SRef<perftest::ILeaf>, xpcf::XPCFErrorCode> extra = factory->tryResolve<perftest::ILeaf>("extra2");
+    BOOST_TEST_CHECK(!extra.hasError());
+
+    // a bound component whose resolution fails still raises an exception
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    BOOST_CHECK_THROW(factory->tryResolve<perftest::INode>(), xpcf::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE( test_optional_injection_benchmark,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::OptionalNode>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("leaf");
+    // resolution plans skip missing optional injectables : only the first resolution in a context looks up their binds
+    auto firstResolution = [&]() {
+        factory->createNewFactoryContext(xpcf::ContextMode::Overlay)->resolve<perftest::INode>();
+    };
+    double unbound = measure(firstResolution, 2000);
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 1);
+    for (auto name : {"extra0", "extra1", "extra2", "extra3"}) {
+        factory->bind(name, xpcf::toUUID<perftest::ILeaf>(), xpcf::toUUID<perftest::Leaf>(), &xpcf::ComponentFactory::create<perftest::Leaf>,
+                      xpcf::BindingScope::Transient, xpcf::BindingRange::Named);
+    }
+    double bound = measure(firstResolution, 2000);
+    BOOST_TEST_CHECK(factory->resolve<perftest::INode>()->sum() == 5);
+    BOOST_TEST_MESSAGE("First resolution of a component with 4 optional injectables: unbound=" << unbound << "us bound=" << bound << "us");
+    BOOST_TEST_WARN(unbound < bound);
+}
+
+BOOST_AUTO_TEST_CASE( test_traits_uuid )
+{
+    BOOST_TEST_CHECK(xpcf::toUUID<perftest::ILeaf>() == xpcf::toUUID("9A1E0F43-6E8B-4F3C-A5E2-1F3A0C9B7D21"));
+    BOOST_TEST_CHECK(xpcf::toUUID<perftest::Leaf>() == xpcf::toUUID("E3B6A0D2-58C1-4F97-8A4D-2C6B1E0F9A53"));
+    BOOST_TEST_CHECK(xpcf::toUUID<xpcf::IComponentIntrospect>() == xpcf::toUUID(xpcf::InterfaceTraits<xpcf::IComponentIntrospect>::UUID));
+    BOOST_TEST_CHECK(xpcf::toUUID<xpcf::IFactory>() == xpcf::toUUID(xpcf::InterfaceTraits<xpcf::IFactory>::UUID));
+
+    SRef<xpcf::IComponentIntrospect> leaf = xpcf::ComponentFactory::create<perftest::Leaf>();
+    constexpr uint32_t bindsCount = 1000;
+    double bindTo = measure([&]() {
+        for (uint32_t i = 0; i < bindsCount; i++) {
+            leaf->bindTo<perftest::ILeaf>();
+        }
+    }, 1000);
+    double parsing = measure([&]() {
+        for (uint32_t i = 0; i < bindsCount; i++) {
+            xpcf::toUUID(xpcf::InterfaceTraits<perftest::ILeaf>::UUID);
+        }
+    }, 1000);
+    BOOST_TEST_MESSAGE(bindsCount << " bindTo<ILeaf>: " << bindTo << "us (" << bindsCount << " runtime uuid parsings: " << parsing << "us)");
+}
+
+BOOST_AUTO_TEST_CASE( test_shared_interface_tables )
+{
+    SRef<xpcf::IComponentIntrospect> first = xpcf::ComponentFactory::create<perftest::Leaf>();
+    allocationsCount = 0;
+    countAllocations = true;
+    SRef<xpcf::IComponentIntrospect> second = xpcf::ComponentFactory::create<perftest::Leaf>();
+    countAllocations = false;
+    uint64_t creationAllocations = allocationsCount;
+    BOOST_TEST_MESSAGE("Heap allocations of a Leaf creation: " << creationAllocations);
+    // the component, its reference count block, its private implementation and its injectables collection : no interface metadata
+    BOOST_TEST_CHECK(creationAllocations <= 4);
+
+    for (auto & leaf : {first, second}) {
+        BOOST_TEST_CHECK(leaf->getNbInterfaces() == 3);
+        BOOST_TEST_CHECK(leaf->implements<perftest::ILeaf>());
+        BOOST_TEST_CHECK(!leaf->implements<perftest::INode>());
+        BOOST_TEST_CHECK(std::string(leaf->getMetadata(xpcf::toUUID<perftest::ILeaf>()).name()) == "ILeaf");
+        BOOST_TEST_CHECK(leaf->bindTo<perftest::ILeaf>()->value() == 1);
+        BOOST_CHECK_THROW(leaf->bindTo<perftest::INode>(), xpcf::InterfaceNotImplementedException);
+    }
+    BOOST_TEST_CHECK((&first->getMetadata(xpcf::toUUID<perftest::ILeaf>()) == &second->getMetadata(xpcf::toUUID<perftest::ILeaf>())));
+
+    constexpr uint32_t componentsCount = 1000;
+    double creation = measure([&]() {
+        for (uint32_t i = 0; i < componentsCount; i++) {
+            xpcf::ComponentFactory::create<perftest::Leaf>();
+        }
+    }, 100);
+    BOOST_TEST_MESSAGE(componentsCount << " Leaf creations: " << creation << "us");
+}
+
+BOOST_AUTO_TEST_CASE( test_bind_to_benchmark )
+{
+    SRef<xpcf::IComponentIntrospect> component = xpcf::ComponentFactory::create<perftest::Leaf>();
+    SRef<perftest::ILeaf> leaf = component->bindTo<perftest::ILeaf>();
+    // interfaces references alias the component reference
+    BOOST_TEST_CHECK(component.use_count() == 2);
+    SRef<xpcf::IInjectable> injectable = leaf->bindTo<xpcf::IInjectable>();
+    BOOST_TEST_CHECK(component.use_count() == 3);
+    component.reset();
+    injectable.reset();
+    // the remaining interface reference keeps the component alive
+    BOOST_TEST_CHECK(leaf->value() == 1);
+    BOOST_TEST_CHECK(leaf->bindTo<xpcf::IComponentIntrospect>()->implements<perftest::ILeaf>());
+
+    constexpr uint32_t bindsCount = 1000;
+    allocationsCount = 0;
+    countAllocations = true;
+    for (uint32_t i = 0; i < bindsCount; i++) {
+        leaf->bindTo<xpcf::IInjectable>()->bindTo<perftest::ILeaf>();
+    }
+    countAllocations = false;
+    BOOST_TEST_MESSAGE("Heap allocations of " << 2 * bindsCount << " bindTo: " << allocationsCount);
+    BOOST_TEST_CHECK(allocationsCount == 0);
+
+    double bindTo = measure([&]() {
+        for (uint32_t i = 0; i < bindsCount; i++) {
+            leaf->bindTo<xpcf::IInjectable>()->bindTo<perftest::ILeaf>();
+        }
+    }, 1000);
+    BOOST_TEST_MESSAGE(2 * bindsCount << " bindTo: " << bindTo << "us");
+
+    // the shared reference is read without locking the component
+    uint32_t threadsCount = maxThreadsCount();
+    double concurrentBindTo = runConcurrently(threadsCount, [&](uint32_t) {
+        for (uint32_t i = 0; i < bindsCount; i++) {
+            leaf->bindTo<xpcf::IInjectable>()->bindTo<perftest::ILeaf>();
+        }
+    });
+    BOOST_TEST_MESSAGE(threadsCount << " threads * " << 2 * bindsCount << " bindTo: " << concurrentBindTo << "us");
+    BOOST_TEST_CHECK(leaf.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_component_ref )
+{
+    perftest::CountedLeaf::destructionsCount = 0;
+    SRef<perftest::ILeaf> shared = xpcf::ComponentFactory::create<perftest::CountedLeaf>()->bindTo<perftest::ILeaf>();
+    xpcf::ComponentRef<perftest::ILeaf> leaf(shared);
+    BOOST_TEST_CHECK(sizeof(leaf) == sizeof(perftest::ILeaf *));
+    BOOST_TEST_CHECK(leaf->value() == 1);
+    BOOST_TEST_CHECK((leaf.bindTo<xpcf::IInjectable>().bindTo<perftest::ILeaf>() == leaf));
+    BOOST_CHECK_THROW(leaf.bindTo<perftest::INode>(), xpcf::InterfaceNotImplementedException);
+
+    allocationsCount = 0;
+    countAllocations = true;
+    {
+        xpcf::ComponentRef<perftest::ILeaf> copy = leaf;
+        xpcf::ComponentRef<xpcf::IInjectable> injectable = copy.bindTo<xpcf::IInjectable>();
+    }
+    countAllocations = false;
+    BOOST_TEST_CHECK(allocationsCount == 0);
+
+    // intrusive and shared references share the component counter
+    shared.reset();
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 0);
+    shared = leaf.toSRef();
+    uint32_t threadsCount = maxThreadsCount();
+    constexpr uint32_t copiesCount = 100000;
+    double intrusive = runConcurrently(threadsCount, [&](uint32_t) {
+        for (uint32_t i = 0; i < copiesCount; i++) {
+            xpcf::ComponentRef<perftest::ILeaf> copy = leaf;
+        }
+    });
+    double aliased = runConcurrently(threadsCount, [&](uint32_t) {
+        for (uint32_t i = 0; i < copiesCount; i++) {
+            SRef<perftest::ILeaf> copy = shared;
+        }
+    });
+    BOOST_TEST_MESSAGE(threadsCount << " threads * " << copiesCount << " copies : ComponentRef " << intrusive << "us, SRef " << aliased << "us");
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 0);
+    // once the shared references are released, the threads race to create the next one
+    shared.reset();
+    runConcurrently(threadsCount, [&](uint32_t) {
+        for (uint32_t i = 0; i < 1000; i++) {
+            SRef<perftest::ILeaf> copy = leaf.toSRef();
+        }
+    });
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 0);
+    shared = leaf.toSRef();
+    leaf.reset();
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 0);
+    shared.reset();
+    BOOST_TEST_CHECK(perftest::CountedLeaf::destructionsCount == 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_shared_injectable_tables )
+{
+    SRef<xpcf::IInjectable> first = xpcf::ComponentFactory::create<perftest::OptionalNode>()->bindTo<xpcf::IInjectable>();
+    allocationsCount = 0;
+    countAllocations = true;
+    SRef<xpcf::IInjectable> second = xpcf::ComponentFactory::create<perftest::OptionalNode>()->bindTo<xpcf::IInjectable>();
+    countAllocations = false;
+    uint64_t creationAllocations = allocationsCount;
+    BOOST_TEST_MESSAGE("Heap allocations of an OptionalNode creation (5 injectables): " << creationAllocations);
+    // the component, its reference count block and its private implementation : no injectable metadata nor injector
+    BOOST_TEST_CHECK(creationAllocations <= 3);
+
+    BOOST_TEST_CHECK(first->getInjectables().size() == 5);
+    BOOST_TEST_CHECK((&first->getInjectables() == &second->getInjectables()));
+    BOOST_TEST_CHECK(second->injectExists<perftest::ILeaf>("extra2"));
+    BOOST_TEST_CHECK(!second->injectExists<perftest::ILeaf>());
+
+    // injectors are shared : they inject the instance they are given
+    SRef<xpcf::IComponentIntrospect> leaf = xpcf::ComponentFactory::create<perftest::Leaf>();
+    for (auto injector : second->getInjectables()) {
+        injector->inject(*second, leaf);
+    }
+    BOOST_TEST_CHECK(second->bindTo<perftest::INode>()->sum() == 5);
+
+    constexpr uint32_t componentsCount = 1000;
+    double creation = measure([&]() {
+        for (uint32_t i = 0; i < componentsCount; i++) {
+            xpcf::ComponentFactory::create<perftest::OptionalNode>();
+        }
+    }, 100);
+    BOOST_TEST_MESSAGE(componentsCount << " OptionalNode creations: " << creation << "us");
+}
+
+BOOST_FIXTURE_TEST_CASE( test_footprint_report,LocalFactoryFixture )
+{
+    factory->bindLocal<perftest::INode, perftest::Node>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>();
+    factory->bindLocal<perftest::ILeaf, perftest::Leaf>("right");
+    double disabled = measure([&]() { factory->resolve<perftest::INode>(); });
+
+    // the test counter reports allocations instead of bytes
+    factory->enableFootprintReport(true, []() -> uint64_t { return allocationsCount; });
+    constexpr uint32_t resolutionsCount = 10;
+    countAllocations = true;
+    for (uint32_t i = 0; i < resolutionsCount; i++) {
+        factory->resolve<perftest::INode>();
+    }
+    countAllocations = false;
+    std::vector<xpcf::ComponentFootprint> report = factory->footprintReport();
+    BOOST_TEST_REQUIRE(report.size() == 2);
+    for (const xpcf::ComponentFootprint & footprint : report) {
+        bool isNode = (footprint.componentUUID == xpcf::toUUID<perftest::Node>());
+        BOOST_TEST_MESSAGE((isNode ? "Node" : "Leaf") << " footprint: size=" << footprint.instanceSize << " instances=" << footprint.instances
+                           << " creation=" << footprint.creationBytes << " allocations/" << footprint.creationDuration.count() << "ns"
+                           << " injection=" << footprint.injectionBytes << " allocations/" << footprint.injectionDuration.count() << "ns");
+        BOOST_TEST_CHECK(footprint.name.empty());
+        BOOST_TEST_CHECK(footprint.instanceSize == (isNode ? sizeof(perftest::Node) : sizeof(perftest::Leaf)));
+        BOOST_TEST_CHECK(footprint.instances == (isNode ? resolutionsCount : 2 * resolutionsCount));
+        BOOST_TEST_CHECK(footprint.creationBytes >= footprint.instances);
+        BOOST_TEST_CHECK(footprint.configurationBytes == 0);
+    }
+    // the leaves creations are not reported upon the node injection
+    const xpcf::ComponentFootprint & node = (report[0].componentUUID == xpcf::toUUID<perftest::Node>()) ? report[0] : report[1];
+    const xpcf::ComponentFootprint & leaf = (report[0].componentUUID == xpcf::toUUID<perftest::Node>()) ? report[1] : report[0];
+    BOOST_TEST_CHECK(node.injectionBytes < leaf.creationBytes);
+
+    double enabled = measure([&]() { factory->resolve<perftest::INode>(); });
+    BOOST_TEST_MESSAGE("Node resolution: footprint report disabled=" << disabled << "us enabled=" << enabled << "us");
+    factory->enableFootprintReport(false);
+    BOOST_TEST_CHECK(factory->footprintReport().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE( test_module_handles,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+    SRef<xpcf::IModuleManager> moduleManager = xpcf::getModuleManagerInstance();
+    // Tuner component, created without injection nor configuration
+    xpcf::uuids::uuid componentUUID = xpcf::toUUID("5644b791-b684-4203-8479-391776f3f623");
+    SPtr<xpcf::ModuleMetadata> moduleInfos = xpcfComponentManager->findModuleMetadata(xpcfComponentManager->getModuleUUID(componentUUID));
+
+    // the module is opened and validated once, then each transient creation only calls its entry point
+    double creation = measure([&]() { moduleManager->createComponent(moduleInfos, componentUUID); });
+    BOOST_TEST_MESSAGE("Transient module component creation: " << creation << "us");
+
+    // live components keep their module loaded : components created by other tests may still be alive
+    moduleManager->enableModulesUnloading(true);
+    SRef<xpcf::IComponentIntrospect> first = moduleManager->createComponent(moduleInfos, componentUUID);
+    uint32_t componentsCount = moduleManager->getComponentsCount(moduleInfos->getUUID());
+    BOOST_TEST_REQUIRE(componentsCount >= 1);
+    SRef<xpcf::IComponentIntrospect> second = moduleManager->createComponent(moduleInfos, componentUUID);
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleInfos->getUUID()) == componentsCount + 1);
+    first.reset();
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleInfos->getUUID()) == componentsCount);
+    BOOST_TEST_CHECK(second->implements<xpcf::IConfigurable>());
+    second.reset();
+    // when no other component is alive, the module is unloaded and opened again upon the next creation
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleInfos->getUUID()) == componentsCount - 1);
+    first = moduleManager->createComponent(moduleInfos, componentUUID);
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleInfos->getUUID()) == componentsCount);
+    BOOST_TEST_CHECK(first->implements<xpcf::IConfigurable>());
+    moduleManager->enableModulesUnloading(false);
+    first.reset();
+    xpcfComponentManager->clear();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_component_factory_table,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+    SRef<xpcf::IModuleManager> moduleManager = xpcf::getModuleManagerInstance();
+    // Tuner, the last component the sample module declares
+    xpcf::uuids::uuid tunerUUID = xpcf::toUUID("5644b791-b684-4203-8479-391776f3f623");
+    SPtr<xpcf::ModuleMetadata> moduleInfos = xpcfComponentManager->findModuleMetadata(xpcfComponentManager->getModuleUUID(tunerUUID));
+    BOOST_TEST_REQUIRE(moduleInfos);
+
+    // the sample module exports the table XPCF_END_COMPONENTS_DECLARATION generates from its declarations
+    boost::dll::shared_library sampleModule(moduleInfos->getFullPath(), boost::dll::load_mode::append_decorations);
+    BOOST_TEST_CHECK(sampleModule.get<uint32_t (void)>(XPCF_GETABIVERSION)() == XPCF_ABI_VERSION);
+    BOOST_TEST_REQUIRE(sampleModule.has(XPCF_GETCOMPONENTFACTORYTABLE));
+    const xpcf::ComponentFactoryTable * table = sampleModule.get<const xpcf::ComponentFactoryTable * (void)>(XPCF_GETCOMPONENTFACTORYTABLE)();
+    BOOST_TEST_REQUIRE(table->size == 6);
+    for (std::size_t i = 1; i < table->size; i++) {
+        BOOST_TEST_CHECK((table->entries[i - 1].uuid < table->entries[i].uuid));
+    }
+
+    // the module manager creates the table components without calling the XPCF_getComponent chain
+    using GetComponentFunction = xpcf::XPCFErrorCode (const xpcf::uuids::uuid &, SRef<xpcf::IComponentIntrospect> &);
+    GetComponentFunction & getComponent = sampleModule.get<GetComponentFunction>(XPCF_GETCOMPONENT);
+    BOOST_TEST_CHECK(moduleManager->createComponent(moduleInfos, tunerUUID)->implements<xpcf::IConfigurable>());
+    double chained = measure([&]() {
+        SRef<xpcf::IComponentIntrospect> componentRef;
+        getComponent(tunerUUID, componentRef);
+    }, 20 * benchmarkIterations);
+    double indexed = measure([&]() { moduleManager->createComponent(moduleInfos, tunerUUID); }, 20 * benchmarkIterations);
+    BOOST_TEST_MESSAGE("Last declared component creation of 6: XPCF_getComponent chain=" << chained << "us ModuleManager::createComponent=" << indexed << "us");
+
+    // the uuids missing from the table fall back to XPCF_getComponent, which doesn't create them either
+    BOOST_CHECK_THROW(moduleManager->createComponent(moduleInfos, xpcf::toUUID<perftest::Leaf>()), xpcf::ConfigurationException);
+
+    // the test module declares its components by hand and doesn't export the table : XPCF_getComponent creates them
+    fs::path testModuleFolder = boost::dll::program_location().parent_path();
+    SPtr<xpcf::ModuleMetadata> tableLessInfos = moduleManager->introspectModule("xpcfTestModule", testModuleFolder.generic_string(utf8).c_str());
+    boost::dll::shared_library tableLessModule(tableLessInfos->getFullPath(), boost::dll::load_mode::append_decorations);
+    BOOST_TEST_CHECK(!tableLessModule.has(XPCF_GETCOMPONENTFACTORYTABLE));
+    xpcf::uuids::uuid tableLessUUID = xpcf::toUUID("9A4E2C71-B6D3-4F08-8E5A-1C7B3D9F0E24");
+    SRef<xpcf::IComponentIntrospect> tableLessComponent = moduleManager->createComponent(tableLessInfos, tableLessUUID);
+    BOOST_TEST_REQUIRE(tableLessComponent);
+    BOOST_TEST_CHECK(tableLessComponent->implements<xpcf::IInjectable>());
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(tableLessInfos->getUUID()) == 1);
+    BOOST_CHECK_THROW(moduleManager->createComponent(tableLessInfos, tunerUUID), xpcf::ConfigurationException);
+    tableLessComponent.reset();
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(tableLessInfos->getUUID()) == 0);
+    xpcfComponentManager->clear();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_modules_discovery,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+    xpcf::uuids::uuid componentUUID = xpcf::toUUID("5644b791-b684-4203-8479-391776f3f623");
+    xpcf::uuids::uuid moduleUUID = xpcfComponentManager->getModuleUUID(componentUUID);
+    std::string modulesFolder = xpcfComponentManager->findModuleMetadata(moduleUUID)->getPath();
+    SRef<xpcf::IRegistryManager> registry = xpcfComponentManager->getFactory()->bindTo<xpcf::IRegistryManager>();
+
+    // each module library of the folder is opened once, the libraries are introspected in parallel
+    double discovery = measure([&]() {
+        xpcfComponentManager->clear();
+        BOOST_TEST_REQUIRE(registry->loadModules(modulesFolder.c_str(), false) == xpcf::XPCFErrorCode::_SUCCESS);
+    }, 20);
+    BOOST_TEST_MESSAGE("Modules folder discovery: " << discovery << "us");
+    BOOST_TEST_CHECK(xpcfComponentManager->getModuleUUID(componentUUID) == moduleUUID);
+    BOOST_TEST_CHECK(xpcfComponentManager->findComponentMetadata(componentUUID));
+    xpcfComponentManager->clear();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_module_index_cache,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::path confPath = "xpcf_registry_test.xml";
+    fs::detail::utf8_codecvt_facet utf8;
+    xpcfComponentManager->load(confPath.generic_string(utf8).c_str());
+    xpcf::uuids::uuid componentUUID = xpcf::toUUID("5644b791-b684-4203-8479-391776f3f623");
+    xpcf::uuids::uuid moduleUUID = xpcfComponentManager->getModuleUUID(componentUUID);
+    std::string modulesFolder = xpcfComponentManager->findModuleMetadata(moduleUUID)->getPath();
+    SRef<xpcf::IRegistryManager> registry = xpcfComponentManager->getFactory()->bindTo<xpcf::IRegistryManager>();
+    // the test cache file doesn't replace the user cache file
+    fs::path cachePath = fs::temp_directory_path() / fs::unique_path("xpcf-%%%%-%%%%-%%%%.cache");
+    registry->setModuleIndexCachePath(cachePath.generic_string(utf8).c_str());
+
+    xpcfComponentManager->clear();
+    BOOST_TEST_CHECK(!registry->verifyModuleIndexCache(modulesFolder.c_str(), false).empty());
+    BOOST_TEST_REQUIRE(registry->buildModuleIndexCache(modulesFolder.c_str(), false) == xpcf::XPCFErrorCode::_SUCCESS);
+    BOOST_TEST_CHECK(fs::exists(cachePath));
+    BOOST_TEST_CHECK(registry->verifyModuleIndexCache(modulesFolder.c_str(), false).empty());
+    std::size_t interfacesCount = registry->getInterfacesMetadata().size();
+
+    // warm loads declare the modules from the cache, without opening their library. The cache is disabled by default
+    double cold = measure([&]() {
+        xpcfComponentManager->clear();
+        registry->loadModules(modulesFolder.c_str(), false);
+    }, 20);
+    registry->enableModuleIndexCache(true);
+    double warm = measure([&]() {
+        xpcfComponentManager->clear();
+        registry->loadModules(modulesFolder.c_str(), false);
+    }, 20);
+    BOOST_TEST_MESSAGE("Modules folder loading: introspection=" << cold << "us module index cache=" << warm << "us");
+    BOOST_TEST_CHECK(xpcfComponentManager->getModuleUUID(componentUUID) == moduleUUID);
+    BOOST_TEST_CHECK(registry->getInterfacesMetadata().size() == interfacesCount);
+    BOOST_TEST_CHECK(xpcfComponentManager->createComponent(componentUUID)->implements<xpcf::IConfigurable>());
+    registry->enableModuleIndexCache(false);
+    registry->setModuleIndexCachePath("");
+    fs::remove(cachePath);
+    xpcfComponentManager->clear();
+}
+
+BOOST_FIXTURE_TEST_CASE( test_module_prefetch,XpcfFixture,* boost::unit_test::depends_on("test_library_component_metadata/test_load_library"))
+{
+    fs::detail::utf8_codecvt_facet utf8;
+    SRef<xpcf::IModuleManager> moduleManager = xpcf::getModuleManagerInstance();
+    // the test module components are only created by the tests releasing them : the module is unloaded with its last component
+    fs::path testModuleFolder = boost::dll::program_location().parent_path();
+    SPtr<xpcf::ModuleMetadata> moduleInfos = moduleManager->introspectModule("xpcfTestModule", testModuleFolder.generic_string(utf8).c_str());
+    xpcf::uuids::uuid componentUUID = xpcf::toUUID("9A4E2C71-B6D3-4F08-8E5A-1C7B3D9F0E24");
+
+    moduleManager->enableModulesUnloading(true);
+    moduleManager->createComponent(moduleInfos, componentUUID);
+    BOOST_TEST_REQUIRE(!moduleManager->isModuleLoaded(moduleInfos->getUUID()));
+    double lazy = measure([&]() { moduleManager->createComponent(moduleInfos, componentUUID); }, 1);
+    BOOST_TEST_CHECK(!moduleManager->isModuleLoaded(moduleInfos->getUUID()));
+
+    moduleManager->prefetchModule(moduleInfos);
+    for (int i = 0; i < 5000 && !moduleManager->isModuleLoaded(moduleInfos->getUUID()); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_TEST_REQUIRE(moduleManager->isModuleLoaded(moduleInfos->getUUID()));
+    SRef<xpcf::IComponentIntrospect> componentRef;
+    double prefetched = measure([&]() { componentRef = moduleManager->createComponent(moduleInfos, componentUUID); }, 1);
+    BOOST_TEST_MESSAGE("First module component creation: lazy loading=" << lazy << "us prefetched=" << prefetched << "us");
+    BOOST_TEST_CHECK(moduleManager->getComponentsCount(moduleInfos->getUUID()) == 1);
+    componentRef.reset();
+    BOOST_TEST_CHECK(!moduleManager->isModuleLoaded(moduleInfos->getUUID()));
+
+    // a module failing to load is logged by the prefetch task, and reported by its first component creation
+    SPtr<xpcf::ModuleMetadata> missingModuleInfos = xpcf::utils::make_shared<xpcf::ModuleMetadata>("xpcfMissingModule", xpcf::toUUID("4C1E8B27-95D0-4A6F-B3E2-D7A0F58C9B61"),
+                                                                                           "module without library", testModuleFolder.generic_string(utf8).c_str());
+    BOOST_CHECK_NO_THROW(moduleManager->prefetchModule(missingModuleInfos));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_TEST_CHECK(!moduleManager->isModuleLoaded(missingModuleInfos->getUUID()));
+    BOOST_CHECK_THROW(moduleManager->createComponent(missingModuleInfos, componentUUID), xpcf::ModuleException);
+    moduleManager->enableModulesUnloading(false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
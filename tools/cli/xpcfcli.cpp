@@ -18,16 +18,62 @@
 
 #include <xpcf/xpcf.h>
 #include <xpcf/api/IModuleManager.h>
+#include <xpcf/api/IRegistryManager.h>
 #include <xpcf/core/refs.h>
 #include <boost/log/core.hpp>
 #include <boost/filesystem.hpp>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <new>
 
 using namespace std;
 
 namespace fs = boost::filesystem;
 namespace xpcf  = org::bcom::xpcf;
 
+// heap bytes allocated by each thread, fed by the global operator new replacement below for the footprint report
+static thread_local uint64_t allocatedBytes = 0;
+
+static uint64_t threadAllocatedBytes()
+{
+    return allocatedBytes;
+}
+
+void * operator new(std::size_t size)
+{
+    allocatedBytes += size;
+    void * ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void * operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
 
 static void usage(const char * appName)
 {
@@ -36,6 +82,132 @@ static void usage(const char * appName)
     cout<<"\t-name [moduleName] : the module name to introspect"<<endl;
     cout<<"\t-path [modulePath]  : the module folder path      => "<<endl;
     cout<<"\t-o [xmlfilepath] : the output xml filename"<<endl;
+    cout<<"Usage :"<<appName<<" -footprint [configurationFilePath] [-format csv|json] [-o outputFilePath]"<<endl;
+    cout<<"\t-footprint [configurationFilePath] : creates each component of the modules declared in the configuration file"<<endl;
+    cout<<"\t\tand reports the size, heap bytes and duration of its creation, injection and configuration"<<endl;
+    cout<<"\t-format [csv|json] : the report format, csv by default"<<endl;
+    cout<<"\t-o [outputFilePath] : the report filename, the standard output by default"<<endl;
+    cout<<"Usage :"<<appName<<" -cache [build|verify] -path [modulesFolderPath]"<<endl;
+    cout<<"\t-cache build : introspects the modules found in the folder and stores their metadata in the module index cache"<<endl;
+    cout<<"\t-cache verify : checks the module index cache entries of the modules found in the folder"<<endl;
+}
+
+static std::string jsonEscape(const std::string & str)
+{
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+static std::string csvEscape(const std::string & str)
+{
+    std::string escaped = "\"";
+    for (char c : str) {
+        if (c == '"') {
+            escaped += '"';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+static void writeFootprintReport(std::ostream & out, const std::vector<xpcf::ComponentFootprint> & report, bool json)
+{
+    if (!json) {
+        out<<"uuid,name,size,instances,creationBytes,creationNs,injectionBytes,injectionNs,configurationBytes,configurationNs"<<endl;
+        for (const xpcf::ComponentFootprint & footprint : report) {
+            out<<footprint.componentUUID<<","<<csvEscape(footprint.name)<<","<<footprint.instanceSize<<","<<footprint.instances<<","
+               <<footprint.creationBytes<<","<<footprint.creationDuration.count()<<","
+               <<footprint.injectionBytes<<","<<footprint.injectionDuration.count()<<","
+               <<footprint.configurationBytes<<","<<footprint.configurationDuration.count()<<endl;
+        }
+        return;
+    }
+    out<<"["<<endl;
+    for (std::size_t i = 0; i < report.size(); i++) {
+        const xpcf::ComponentFootprint & footprint = report[i];
+        out<<"  {\"uuid\": \""<<footprint.componentUUID<<"\", \"name\": \""<<jsonEscape(footprint.name)<<"\""
+           <<", \"size\": "<<footprint.instanceSize<<", \"instances\": "<<footprint.instances
+           <<", \"creationBytes\": "<<footprint.creationBytes<<", \"creationNs\": "<<footprint.creationDuration.count()
+           <<", \"injectionBytes\": "<<footprint.injectionBytes<<", \"injectionNs\": "<<footprint.injectionDuration.count()
+           <<", \"configurationBytes\": "<<footprint.configurationBytes<<", \"configurationNs\": "<<footprint.configurationDuration.count()
+           <<"}"<<(i + 1 < report.size() ? "," : "")<<endl;
+    }
+    out<<"]"<<endl;
+}
+
+static int footprint(const std::string & configurationFilePath, const std::string & format, const std::string & outputFilePath)
+{
+    if (format != "csv" && format != "json") {
+        cout<<"Unknown report format :"<<format<<endl;
+        return -1;
+    }
+    SRef<xpcf::IComponentManager> xpcfComponentManager = xpcf::getComponentManagerInstance();
+    if (xpcfComponentManager->load(configurationFilePath.c_str()) != xpcf::XPCFErrorCode::_SUCCESS) {
+        cout<<"Failed to load the configuration file :"<<configurationFilePath<<endl;
+        return -1;
+    }
+    SRef<xpcf::IFactory> factory = xpcfComponentManager->getFactory();
+    factory->enableFootprintReport(true, &threadAllocatedBytes);
+    for (SPtr<xpcf::ModuleMetadata> moduleInfos : xpcfComponentManager->getModulesMetadata()) {
+        for (xpcf::uuids::uuid componentUUID : moduleInfos->getComponents()) {
+            try {
+                xpcfComponentManager->createComponent(componentUUID);
+            }
+            catch (const std::exception & e) {
+                cerr<<"Component UUID='"<<componentUUID<<"' not reported : "<<e.what()<<endl;
+            }
+        }
+    }
+    std::vector<xpcf::ComponentFootprint> report = factory->footprintReport();
+    factory->enableFootprintReport(false);
+    if (outputFilePath.empty()) {
+        writeFootprintReport(cout, report, format == "json");
+        return 0;
+    }
+    std::ofstream out(outputFilePath);
+    if (!out) {
+        cout<<"Unable to write the report file :"<<outputFilePath<<endl;
+        return -1;
+    }
+    writeFootprintReport(out, report, format == "json");
+    return 0;
+}
+
+static int moduleIndexCache(const std::string & command, const std::string & modulesFolderPath)
+{
+    if (command != "build" && command != "verify") {
+        cout<<"Unknown module index cache command :"<<command<<endl;
+        return -1;
+    }
+    if (modulesFolderPath.empty()) {
+        cout<<"Missing modules folder path, use -path [modulesFolderPath]"<<endl;
+        return -1;
+    }
+    SRef<xpcf::IComponentManager> xpcfComponentManager = xpcf::getComponentManagerInstance();
+    SRef<xpcf::IRegistryManager> registry = xpcfComponentManager->getFactory()->bindTo<xpcf::IRegistryManager>();
+    if (command == "build") {
+        if (registry->buildModuleIndexCache(modulesFolderPath.c_str()) != xpcf::XPCFErrorCode::_SUCCESS) {
+            cout<<"Failed to find the modules folder :"<<modulesFolderPath<<endl;
+            return -1;
+        }
+        cout<<"Module index cache updated with "<<registry->getModulesMetadata().size()<<" modules"<<endl;
+        return 0;
+    }
+    std::vector<std::string> outdatedModules = registry->verifyModuleIndexCache(modulesFolderPath.c_str());
+    for (const std::string & modulePath : outdatedModules) {
+        cout<<"Missing or outdated module index cache entry :"<<modulePath<<endl;
+    }
+    if (!outdatedModules.empty()) {
+        return 1;
+    }
+    cout<<"Module index cache up to date"<<endl;
+    return 0;
 }
 
 void displayParameter(SRef<xpcf::IProperty> p)
@@ -90,6 +262,9 @@ int main(int argc, char **argv) {
     options["-name"]="";
     options["-path"]="";
     options["-o"]="";
+    options["-footprint"]="";
+    options["-format"]="csv";
+    options["-cache"]="";
     std::string name,path,outputFilePath;
 
     while (optionIndex >= 1) {
@@ -131,6 +306,16 @@ int main(int argc, char **argv) {
     }
     xpcf::uuids::uuid iid_IComponentIntrospect= xpcf::toUUID<xpcf::IComponentIntrospect>();
 
+    if (!options["-footprint"].empty()) {
+        boost::log::core::get()->set_logging_enabled(false);
+        return footprint(options["-footprint"], options["-format"], options["-o"]);
+    }
+
+    if (!options["-cache"].empty()) {
+        boost::log::core::get()->set_logging_enabled(false);
+        return moduleIndexCache(options["-cache"], options["-path"]);
+    }
+
     //Initialize default ssl key dir to root configuration dir
     name = options["-name"];
     path = options["-path"];
@@ -3,7 +3,7 @@ CONFIG -= app_bundle qt
 
 TARGET = xpcf
 FRAMEWORK = $${TARGET}
-VERSION=2.6.3
+VERSION=2.7.0
 
 DEFINES += XPCFVERSION=\\\"$${VERSION}\\\"
 
@@ -106,6 +106,10 @@ SOURCES += \
     src/PropertyManager.cpp \
     src/ConfigurableBase.cpp \
     src/BaseTask.cpp \
+    src/TaskPool.cpp \
+    src/Logger.cpp \
+    src/FootprintRecorder.cpp \
+    src/ModuleIndexCache.cpp \
     src/ErrorMessage.cpp
 
 HEADERS += \
@@ -118,6 +122,7 @@ HEADERS += \
     interfaces/xpcf/threading/MultiConsumer.h \
     interfaces/private/xpcf/AliasManager.h \
     interfaces/private/xpcf/Factory.h \
+    interfaces/private/xpcf/FlatHashTable.h \
     interfaces/private/xpcf/Registry.h \
     interfaces/private/xpcf/tinyxml2.h \
     interfaces/private/xpcf/tinyxmlhelper.h \
@@ -130,6 +135,10 @@ HEADERS += \
     interfaces/private/xpcf/PropertySequenceWrapper.h \
     interfaces/private/xpcf/PropertyWrapper.h \
     interfaces/private/xpcf/PropertyManager.h \
+    interfaces/private/xpcf/TaskPool.h \
+    interfaces/private/xpcf/Logger.h \
+    interfaces/private/xpcf/FootprintRecorder.h \
+    interfaces/private/xpcf/ModuleIndexCache.h \
     interfaces/xpcf/core/Result.h \
     interfaces/xpcf/core/ErrorMessage.h \
     interfaces/xpcf/core/Exception.h \
@@ -149,8 +158,10 @@ HEADERS += \
     interfaces/xpcf/api/IFactory.h \
     interfaces/xpcf/component/ComponentBase.h \
     interfaces/xpcf/component/ComponentFactory.h \
+    interfaces/xpcf/component/ComponentRef.h \
     interfaces/xpcf/component/ComponentTraits.h \
     interfaces/xpcf/component/ConfigurableBase.h \
+    interfaces/xpcf/component/Lazy.h \
     interfaces/xpcf/module/IModuleIndex.h \
     interfaces/xpcf/module/ModuleFactory.h \
     interfaces/xpcf/properties/IProperty.h \